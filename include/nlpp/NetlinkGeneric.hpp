@@ -7,19 +7,52 @@
  * Contains the `NetlinkGeneric` class definition.
  */
 
+#include "error.hpp"
+#include "generator.hpp"
+#include "nlmsg_pool_t.hpp"
 #include "nlpp.hpp"
+#include "nlreactor_t.hpp"
 #include "nlsocket_t.hpp"
+#include "task.hpp"
 
 #include <linux/nl80211.h>
 #include <netlink/genl/ctrl.h>
 #include <netlink/genl/genl.h>
 
+#include <bitset>
+#include <chrono>
+#include <functional>
 #include <map>
+#include <memory>
+#include <optional>
+#include <span>
+#include <utility>
+#include <vector>
 
 
 namespace nlpp {
 
 
+/// @brief Prebuilt `set_if_frequency()` request of a device.
+/// @details Built once by `NetlinkGeneric::prepare_set_if_frequency()`, then
+///          each send patches the frequency in place and bumps the sequence.
+struct freq_request_t
+{
+  nlmsg_t msg;              ///< Encoded `NL80211_CMD_SET_WIPHY` request
+  nlslot_t<uint32_t> freq;  ///< `NL80211_ATTR_WIPHY_FREQ` payload in `msg`
+};
+
+
+/// @brief Set of `nl80211_protocol_features` bits.
+using protocol_features_t = std::bitset<32>;
+
+/// @brief Visitor of a streaming interface dump. Returns false to stop it.
+using dev_info_visitor_t = std::function<bool(dev_info_t&&)>;
+
+/// @brief Visitor of a streaming phy dump. Returns false to stop it.
+using dev_capability_visitor_t = std::function<bool(dev_capability_t&&)>;
+
+
 /**
  * @brief Utility whose API is mapped to some `iw` commands.
  * 
@@ -29,29 +62,106 @@ namespace nlpp {
  * - `get_list_interfaces()` -> `iw dev`
  * - `set_if_type()` -> `iw dev <devname> set type <type>`
  * - `set_if_channel()` -> `iw dev <devname> set channel <channel>`
+ *
+ * Every throwing method has a `try_*` counterpart that returns an
+ * `expected` carrying the errno and the nl80211 command instead of throwing.
+ *
+ * Requests wait at most `socket().timeout()`, then fail with `ETIMEDOUT`.
+ * The frequency setters also accept a timeout for a single call.
+ *
+ * When `socket().autotune()` is enabled, a dump that overran the socket 
+ * buffers is issued once more after the buffers have grown.
+ *
+ * Requests are built in small buffers recycled by a private `nlmsg_pool_t`,
+ * so the steady-state request path does not allocate messages.
  */
 class NetlinkGeneric
 {
 public:
 
   /// @brief Default ctor. Connect to Netlink Generic subsystem.
-  /// @throw `std::system_error` when `genl_ctrl_resolve()` call fails.
+  /// @throw `std::system_error` when nl80211 cannot be resolved.
+  /// @details The family id comes from `genl_family_cache_t`, so only the
+  ///          first object of the process pays for the resolution.
+  /// @details Strict checking is enabled when the kernel supports it, so 
+  ///          dumps honour their filter attributes.
   NetlinkGeneric();
 
+  /// @brief Returns the socket connected to the genl subsystem.
+  /// @note Register it with an `nlreactor_t` to issue asynchronous requests.
+  [[nodiscard]] nlsocket_t& socket() noexcept { return this->socket_; }
+
+  /// @brief Returns the resolved nl80211 family identifier.
+  [[nodiscard]] int family_id() const noexcept { return this->nl80211_id_; }
+
+  /// @brief Returns the nl80211 protocol features, probed at construction.
+  [[nodiscard]] protocol_features_t protocol_features() const noexcept 
+  { 
+    return this->protocol_features_; 
+  }
+
+  /// @brief Checks a nl80211 protocol feature.
+  /// @param[in] feature A `NL80211_PROTOCOL_FEATURE_*` bit.
+  /// @returns true if the kernel has it.
+  [[nodiscard]] bool 
+    has_protocol_feature(nl80211_protocol_features feature) const noexcept
+  {
+    return (this->protocol_features_.to_ulong() & feature) != 0;
+  }
+
+  /// @brief Decode a `NL80211_CMD_NEW_INTERFACE` message, either a reply or
+  ///        a `config` notification (`NEW`/`SET`/`DEL_INTERFACE`).
+  /// @returns The device info, with a zero `if_index` for a non-netdev.
+  [[nodiscard]] static dev_info_t decode_interface(nlmsg_view_t msg);
+
 //* libnl API / / / / / / / / / / / / / / / / / / / / / / / / / / / / / / / / / 
 
   /// @brief Obtain information for a device.
   /// @param[in] if_index Interface index.
-  /// @throws `std::system_error` when `if_index_t` is invalid.
+  /// @throws `std::invalid_argument` when `if_index` is zero, 
+  ///         `std::system_error` when the request fails.
   /// @returns A `dev_info_t` oebject about a device.
   /// @pre `if_index` must be a valid device index.
   /// @note This method corresponds to `iw dev <devname> info` command.
   [[nodiscard]] dev_info_t get_interface(if_index_t if_index);
+
+  /// @brief Non-throwing version of `get_interface()`.
+  /// @returns The device info, `EINVAL` if `if_index` is zero or `ENODEV`
+  ///          if the device does not exist.
+  [[nodiscard]] expected<dev_info_t> try_get_interface(if_index_t if_index);
   
+  /// @brief Obtain information for many devices in a single round trip.
+  /// @param[in] if_indexes Interface indexes.
+  /// @returns A `dev_info_t` map where key is the device index.
+  /// @throws `std::system_error` when a request fails.
+  /// @note Requests are pipelined with `nlsocket_t::transact()`.
+  [[nodiscard]] std::map<uint32_t,dev_info_t> 
+    get_interfaces(std::span<if_index_t const> if_indexes);
+
+  /// @brief Non-throwing version of `get_interfaces()`.
+  [[nodiscard]] expected<std::map<uint32_t,dev_info_t>> 
+    try_get_interfaces(std::span<if_index_t const> if_indexes);
+
   /// @brief Obtain a map of all devices info.
   /// @returns A `dev_info_t` map where key is the device index .
   /// @note This method correspond to `iw dev` command.
   [[nodiscard]] std::map<uint32_t,dev_info_t> get_list_interfaces();
+
+  /// @brief Non-throwing version of `get_list_interfaces()`.
+  [[nodiscard]] expected<std::map<uint32_t,dev_info_t>> 
+    try_get_list_interfaces();
+
+  /// @brief Obtain a map of the devices of a physical device.
+  /// @param[in] phy_index Physical device index.
+  /// @returns A `dev_info_t` map where key is the device index.
+  /// @details The dump carries `NL80211_ATTR_WIPHY`, so the kernel only 
+  ///          returns the interfaces of `phy_index`.
+  [[nodiscard]] std::map<uint32_t,dev_info_t> 
+    get_list_interfaces(wiphy_index_t phy_index);
+
+  /// @brief Non-throwing version of `get_list_interfaces(wiphy_index_t)`.
+  [[nodiscard]] expected<std::map<uint32_t,dev_info_t>> 
+    try_get_list_interfaces(wiphy_index_t phy_index);
    
   /// @brief Get capabilities for the specified wireless device.
   /// @param[in] phy_index Physical device index.
@@ -59,10 +169,18 @@ public:
   /// @note This method corresponds to `iw phy <phyname> info`.
   [[nodiscard]] dev_capability_t get_phy(wiphy_index_t phy_index);
 
+  /// @brief Non-throwing version of `get_phy()`.
+  /// @returns The device capability, or `ENODEV` if the device does not exist.
+  [[nodiscard]] expected<dev_capability_t> try_get_phy(wiphy_index_t phy_index);
+
 
   /// @brief Get the list phy object.
   /// @return std::map<uint32_t,dev_capability_t> 
   [[nodiscard]] std::map<uint32_t,dev_capability_t> get_list_phys();
+
+  /// @brief Non-throwing version of `get_list_phys()`.
+  [[nodiscard]] expected<std::map<uint32_t,dev_capability_t>> 
+    try_get_list_phys();
   
   /// @brief Change the interface type.
   /// @param[in] ifname Interface name.
@@ -70,45 +188,326 @@ public:
   /// @pre Link must be put down (otherwise it throws resource busy).
   /// @note This method corresponds to `iw dev <devname> set type <type>`.
   void set_if_type(std::string const& ifname, if_type_e type);
+
+  /// @brief Non-throwing version of `set_if_type()`.
+  /// @returns Nothing, `ENODEV` if `ifname` does not exist or the kernel error.
+  [[nodiscard]] expected<> 
+    try_set_if_type(std::string const& ifname, if_type_e type);
   
   /// @brief Set the frequency.
   /// @param[in] ifname Interface name.
   /// @param[in] freq Frequency to set.
+  /// @param[in] timeout Optional timeout overriding the socket timeout.
   /// @pre Link must be in monitor mode and up (oyherwise throws resource busy).
   /// @note This method corresponds to `iw dev <devname> set freq <freq>`.
-  void set_if_frequency(std::string const& ifname, frequency_t freq);
+  void set_if_frequency(std::string const& ifname, frequency_t freq,
+                        std::optional<std::chrono::milliseconds> timeout = {});
+
+  /// @brief Non-throwing version of `set_if_frequency()`.
+  [[nodiscard]] expected<> 
+    try_set_if_frequency(std::string const& ifname, frequency_t freq,
+                         std::optional<std::chrono::milliseconds> timeout = {});
+
+  /// @brief Set the frequency of many interfaces in a single round trip.
+  /// @param[in] changes Pairs of interface name and frequency to set.
+  /// @param[in] timeout Optional timeout of the whole batch.
+  /// @throws `std::system_error` when a request fails.
+  /// @note Requests are pipelined with `nlsocket_t::transact()`.
+  void set_if_frequency(
+    std::span<std::pair<std::string,frequency_t> const> changes,
+    std::optional<std::chrono::milliseconds> timeout = {});
+
+  /// @brief Non-throwing version of the batched `set_if_frequency()`.
+  /// @returns Nothing, or the error of the first failed request.
+  [[nodiscard]] expected<> try_set_if_frequency(
+    std::span<std::pair<std::string,frequency_t> const> changes,
+    std::optional<std::chrono::milliseconds> timeout = {});
+
+  /// @brief Encode a `set_if_frequency()` request once, to send it many times.
+  /// @param[in] ifname Interface name.
+  /// @throws `std::system_error` with `ENODEV` if the interface is unknown.
+  /// @note The request owns its message and may outlive this object.
+  [[nodiscard]] freq_request_t prepare_set_if_frequency(std::string const& ifname);
+
+  /// @brief Non-throwing version of `prepare_set_if_frequency()`.
+  [[nodiscard]] expected<freq_request_t> 
+    try_prepare_set_if_frequency(std::string const& ifname) noexcept;
+
+  /// @brief Set the frequency with a prebuilt request.
+  /// @details One store into the encoded message, then a send.
+  void set_if_frequency(freq_request_t& request, frequency_t freq,
+                        std::optional<std::chrono::milliseconds> timeout = {});
+
+  /// @brief Non-throwing version of the prebuilt `set_if_frequency()`.
+  [[nodiscard]] expected<> 
+    try_set_if_frequency(freq_request_t& request, frequency_t freq,
+                         std::optional<std::chrono::milliseconds> timeout = {}) noexcept;
 
   /// @brief Set the channel frequency.
   /// @param[in] ifname Interface name.
   /// @param[in] chan Channel frequency to set.
+  /// @param[in] timeout Optional timeout overriding the socket timeout.
   /// @pre Link must be in monitor mode and up (oyherwise throws resource busy).
   /// @note This method corresponds to `iw dev <devname> set channel <channel>`.
-  void set_if_channel(std::string const& ifname, channel_freq_t chan);
+  void set_if_channel(std::string const& ifname, channel_freq_t chan,
+                      std::optional<std::chrono::milliseconds> timeout = {});
+
+  /// @brief Non-throwing version of `set_if_channel()`.
+  [[nodiscard]] expected<> 
+    try_set_if_channel(std::string const& ifname, channel_freq_t chan,
+                       std::optional<std::chrono::milliseconds> timeout = {});
+
+//* Streaming API / / / / / / / / / / / / / / / / / / / / / / / / / / / / / / /
+
+  /// @brief Visit the devices info as the dump arrives.
+  /// @param[in] visitor Called once per device. Returning false stops the 
+  ///            visit: the rest of the dump is read and discarded, since
+  ///            the kernel refuses a new dump on the socket until it ends.
+  /// @param[in] phy_index Optional physical device filter.
+  /// @throws `std::system_error` when the request fails.
+  /// @details Unlike `get_list_interfaces()` nothing is collected: memory is
+  ///          bounded by a datagram. "Unnamed/non-netdev interfaces" are 
+  ///          skipped, and a dump which overran is not retried.
+  void for_each_interface(dev_info_visitor_t const& visitor, 
+                          std::optional<wiphy_index_t> phy_index = {});
+
+  /// @brief Non-throwing version of `for_each_interface()`.
+  [[nodiscard]] expected<> 
+    try_for_each_interface(dev_info_visitor_t const& visitor, 
+                           std::optional<wiphy_index_t> phy_index = {});
+
+  /// @brief Visit the capabilities of each phy as the dump arrives.
+  /// @param[in] visitor Called once per phy, when all its split messages 
+  ///            are parsed. Returning false stops the dump.
+  /// @throws `std::system_error` when the request fails.
+  /// @details Only one `dev_capability_t` is held at a time.
+  void for_each_phy(dev_capability_visitor_t const& visitor);
+
+  /// @brief Non-throwing version of `for_each_phy()`.
+  [[nodiscard]] expected<> try_for_each_phy(dev_capability_visitor_t const& visitor);
+
+  /// @brief Range version of `for_each_interface()`.
+  /// @throws `std::system_error` while iterating, when the request fails.
+  /// @warning The dump runs while the range is iterated: no other request
+  ///          may be issued on this object until it is exhausted or 
+  ///          destroyed. Breaking out of the loop, or destroying the range,
+  ///          reads and discards the rest of the dump.
+  [[nodiscard]] generator<dev_info_t> 
+    stream_interfaces(std::optional<wiphy_index_t> phy_index = {});
+
+  /// @brief Range version of `for_each_phy()`.
+  /// @warning See `stream_interfaces()`.
+  [[nodiscard]] generator<dev_capability_t> stream_phys();
+
+//* No-wait API / / / / / / / / / / / / / / / / / / / / / / / / / / / / / / / /
+
+  /// @brief Queue a `set_if_type()` without waiting for the kernel ACK.
+  /// @returns The sequence number of the request, or the send error.
+  /// @details The kernel error, if any, is reported later by 
+  ///          `collect_errors()` or by the ack handler of `socket()`.
+  [[nodiscard]] expected<uint32_t> 
+    post_set_if_type(std::string const& ifname, if_type_e type);
+
+  /// @brief Queue a `set_if_frequency()` without waiting for the kernel ACK.
+  /// @returns The sequence number of the request, or the send error.
+  [[nodiscard]] expected<uint32_t> 
+    post_set_if_frequency(std::string const& ifname, frequency_t freq);
+
+  /// @brief Queue a `set_if_channel()` without waiting for the kernel ACK.
+  /// @returns The sequence number of the request, or the send error.
+  [[nodiscard]] expected<uint32_t> 
+    post_set_if_channel(std::string const& ifname, channel_freq_t chan);
+
+  /// @brief Queue a prebuilt `set_if_frequency()` request.
+  /// @returns The sequence number of the request, or the send error.
+  /// @details Nothing is encoded nor allocated: the hot path of a hopper.
+  [[nodiscard]] expected<uint32_t> 
+    post_set_if_frequency(freq_request_t& request, frequency_t freq) noexcept;
+
+  /// @brief Queue a prebuilt `set_if_frequency()` request for a channel.
+  [[nodiscard]] expected<uint32_t> 
+    post_set_if_channel(freq_request_t& request, channel_freq_t chan) noexcept;
+
+  /// @brief Process the ACKs received so far.
+  /// @returns The errors of the posted requests, keyed by sequence number.
+  /// @throws `std::system_error` when the receive fails.
+  /// @note Use `socket().flush()` to wait for every outstanding ACK.
+  [[nodiscard]] std::vector<nlack_t> collect_errors();
+
+//* Coroutine API / / / / / / / / / / / / / / / / / / / / / / / / / / / / / / /
+
+  /// @brief Register the socket with a reactor to enable the `async_*` API.
+  /// @param[in] reactor Reactor that resumes the coroutines. It must outlive 
+  ///            this object, and this object must not move afterwards.
+  /// @throws `std::system_error` when the registration fails.
+  /// @note Blocking calls still work, but must not be issued while 
+  ///       asynchronous requests are pending on this object.
+  void attach(nlreactor_t& reactor);
+
+  /// @brief Awaitable version of `get_interface()`.
+  /// @throws `std::logic_error` if not attached to a reactor.
+  [[nodiscard]] task<dev_info_t> async_get_interface(if_index_t if_index);
+
+  /// @brief Awaitable version of `get_list_interfaces()`.
+  [[nodiscard]] task<std::map<uint32_t,dev_info_t>> async_get_list_interfaces();
+
+  /// @brief Awaitable version of `get_phy()`.
+  [[nodiscard]] task<dev_capability_t> async_get_phy(wiphy_index_t phy_index);
+
+  /// @brief Awaitable version of `get_list_phys()`.
+  [[nodiscard]] task<std::map<uint32_t,dev_capability_t>> async_get_list_phys();
+
+  /// @brief Awaitable version of `set_if_type()`.
+  [[nodiscard]] task<> async_set_if_type(std::string const& ifname, 
+                                         if_type_e type);
+
+  /// @brief Awaitable version of `set_if_frequency()`.
+  [[nodiscard]] task<> async_set_if_frequency(std::string const& ifname, 
+                                              frequency_t freq);
+
+  /// @brief Awaitable version of `set_if_channel()`.
+  [[nodiscard]] task<> async_set_if_channel(std::string const& ifname, 
+                                            channel_freq_t chan);
 
 private:
 
-  /// @brief Send a netlink message.
+  /// @brief Send a netlink message and wait for the reply.
   /// @param[in] msg Netlink message.
   /// @param[in] fun Optional callback function.
   /// @param[in] arg Optional callback function parameter.
+  /// @param[in] timeout Optional timeout overriding the socket timeout.
   /// @note You can address commands to a device only through his index.
-  void send_msg(nlmsg_t const& msg, nl_recvmsg_msg_cb_t = {}, void* = {});
+  [[nodiscard]] expected<> try_send_msg(nlmsg_t const& msg, 
+    nl_recvmsg_msg_cb_t = {}, void* = {},
+    std::optional<std::chrono::milliseconds> timeout = {}) noexcept;
+
+  /// @brief Send a batch of netlink messages in a single round trip.
+  /// @param[inout] batch Requests to send.
+  /// @param[in] timeout Optional timeout of the whole batch.
+  /// @returns Nothing, or the error of the first failed request.
+  [[nodiscard]] expected<> try_send_batch(std::span<nlrequest_t> batch,
+    std::optional<std::chrono::milliseconds> timeout = {}) noexcept;
+
+  /// @brief Send `NL80211_CMD_GET_PROTOCOL_FEATURES`.
+  /// @returns The `NL80211_ATTR_PROTOCOL_FEATURES` bits.
+  [[nodiscard]] expected<uint32_t> try_probe_protocol_features();
+
+  /// @brief Returns true if the kernel supports split wiphy dumps.
+  [[nodiscard]] bool split_wiphy() const noexcept
+  {
+    return this->has_protocol_feature(NL80211_PROTOCOL_FEATURE_SPLIT_WIPHY_DUMP);
+  }
+
+  /// @brief Dump one or all the phys.
+  [[nodiscard]] expected<std::map<uint32_t,dev_capability_t>> 
+    try_dump_phys(std::optional<wiphy_index_t> phy_index);
+
+  /// @brief Send a message through the attached reactor.
+  /// @throws `std::logic_error` if not attached to a reactor.
+  [[nodiscard]] nlreactor_t::request_awaiter 
+    async_send(nlmsg_t msg, nl_recvmsg_msg_cb_t = {}, void* = {});
+
+  /// @brief Send a message through the attached reactor and wait for the ACK.
+  [[nodiscard]] task<> async_request(nlmsg_t msg);
+
+  /// @brief Build a `NL80211_CMD_GET_INTERFACE` message for a device.
+  /// @returns The message, or `EINVAL` when `ifindex` is zero.
+  [[nodiscard]] expected<nlmsg_t> make_get_interface(if_index_t ifindex) noexcept;
+
+  /// @brief Build a `NL80211_CMD_GET_INTERFACE` dump message.
+  /// @param[in] phy_index Optional physical device filter.
+  [[nodiscard]] expected<nlmsg_t> 
+    make_dump_interfaces(std::optional<wiphy_index_t> phy_index) noexcept;
+
+  /// @brief Dump the interfaces, all or those of a physical device.
+  [[nodiscard]] expected<std::map<uint32_t,dev_info_t>> 
+    try_dump_interfaces(std::optional<wiphy_index_t> phy_index);
+
+  /// @brief Send a streaming interface dump, read by `recv_raw_next()`.
+  [[nodiscard]] expected<> 
+    try_start_interfaces(std::optional<wiphy_index_t> phy_index);
+
+  /// @brief Send a streaming phy dump, read by `recv_raw_next()`.
+  [[nodiscard]] expected<> try_start_phys();
+
+  /// @brief Build a `NL80211_CMD_GET_WIPHY` message.
+  /// @param[in] phy_index Optional physical device, all devices if empty.
+  /// @param[in] split True if the kernel supports split wiphy dumps.
+  [[nodiscard]] expected<nlmsg_t> 
+    make_get_wiphy(std::optional<wiphy_index_t> phy_index, bool split) noexcept;
+
+  /// @brief Build a `NL80211_CMD_SET_INTERFACE` message to set a type.
+  [[nodiscard]] expected<nlmsg_t> 
+    make_set_type(uint32_t ifindex, if_type_e type) noexcept;
+
+  /// @brief Build a `NL80211_CMD_SET_WIPHY` message to set a frequency.
+  /// @param[in] pooled False for a message that may outlive this object.
+  [[nodiscard]] expected<nlmsg_t> make_set_frequency(
+    uint32_t ifindex, frequency_t freq, bool pooled = true) noexcept;
 
 //* Commands handlers callbacks / / / / / / / / / / / / / / / / / / / / / / / / 
 
+  /// @brief Per-request state of a `NL80211_CMD_GET_INTERFACE` request.
+  struct interface_dump_t
+  {
+    std::map<uint32_t,dev_info_t> result; // key is device index
+    int err{};  // `ENOMEM` when a device could not be stored
+  };
+
   /// @brief Callback to parse a `NL80211_CMD_GET_INTERFACE` response.
+  /// @param[in] arg An `interface_dump_t`.
   static int get_interface_handler(struct nl_msg* msg, void* arg) noexcept;
 
   /// @brief Callback to parse a `NL80211_CMD_GET_PROTOCOL_FEATURES` response.
   static int get_feature_handler(struct nl_msg* msg, void* arg) noexcept;
   
+  /// @brief Per-request state of a `NL80211_CMD_GET_WIPHY` (split) dump.
+  /// @details Owned by the request, so that dumps of different objects and
+  ///          threads, or overlapping coroutines, never share state.
+  struct phy_dump_t
+  {
+    std::map<uint32_t,dev_capability_t> result; // key is wiphy index
+    dev_capability_t* current{};  // phy of the last message, in `result`
+    int err{};  // `ENOMEM` when a phy could not be stored
+  };
+
   /// @brief Callback to parse a `NL80211_CMD_GET_WIPHY` response.
+  /// @param[in] arg A `phy_dump_t`.
   static int get_phy_handler(struct nl_msg* msg, void* arg) noexcept;
 
+  /// @brief State of a streaming `NL80211_CMD_GET_INTERFACE` dump.
+  struct interface_stream_t
+  {
+    std::vector<dev_info_t> ready;  // devices of a datagram
+    int err{};  // `ENOMEM` when a device could not be stored
+  };
+
+  /// @brief Zero-copy callback of a streaming `NL80211_CMD_GET_INTERFACE` dump.
+  /// @param[in] arg An `interface_stream_t`.
+  static int stream_interface_handler(nlmsg_view_t msg, void* arg) noexcept;
+
+  /// @brief State of a streaming `NL80211_CMD_GET_WIPHY` dump.
+  struct phy_stream_t
+  {
+    std::optional<dev_capability_t> current;  // phy still being received
+    std::vector<dev_capability_t> ready;      // phys completed by a datagram
+    int err{};  // `ENOMEM` when a phy could not be stored
+  };
+
+  /// @brief Zero-copy callback of a streaming `NL80211_CMD_GET_WIPHY` dump.
+  /// @param[in] arg A `phy_stream_t`.
+  static int stream_phy_handler(nlmsg_view_t msg, void* arg) noexcept;
+
 //* Representation
 
+  /// @brief Size of the request buffers: requests carry a few attributes.
+  static constexpr std::size_t request_msg_size = 256;
+
+  std::unique_ptr<nlmsg_pool_t> pool_;  // request buffers, stable across moves
   nlsocket_t socket_; // used to connect to genl service
   int nl80211_id_;
+  protocol_features_t protocol_features_;  // probed once, by the ctor
+  nlreactor_t* reactor_{};  // optional, enables the coroutine API
 };
 
 
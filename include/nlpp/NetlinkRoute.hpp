@@ -8,9 +8,14 @@
  */
 
 
+#include "error.hpp"
 #include "nlpp.hpp"
+#include "nlreactor_t.hpp"
 #include "nlsocket_t.hpp"
 #include "rtnl_link_t.hpp"
+#include "task.hpp"
+
+#include <vector>
 
 
 namespace nlpp {
@@ -27,30 +32,86 @@ public:
   /// @brief Connect to the Netlink Route subsystem.
   NetlinkRoute();
 
+  /// @brief Returns the socket connected to the routing subsystem.
+  [[nodiscard]] nlsocket_t& socket() noexcept { return this->socket_; }
+
 //* libnl API / / / / / / / / / / / / / / / / / / / / / / / / / / / / / / / / / 
 
   /// @brief Obtain a link object representing a device from his index.
   /// @param[in] ifindex Interface index identifier.
   /// @returns A ``rtnl_link_t` link object  representing the device.
-  /// @throws `std::runtime_error` when `rtnl_link_get_kernel()` fails.
+  /// @throws `std::system_error` when `rtnl_link_get_kernel()` fails.
   [[nodiscard]] rtnl_link_t get_kernel(if_index_t ifindex);
 
+  /// @brief Non-throwing version of `get_kernel()`.
+  [[nodiscard]] expected<rtnl_link_t> try_get_kernel(if_index_t ifindex) noexcept;
+
   /// @brief Obtain a link object representing a device from his name.
   /// @param[in] ifname Interface name identifier.
   /// @returns A ``rtnl_link_t` link object  representing the device.
-  /// @throws `std::runtime_error` when `rtnl_link_get_kernel()` fails.
+  /// @throws `std::system_error` when `rtnl_link_get_kernel()` fails.
   [[nodiscard]] rtnl_link_t get_kernel(std::string const& ifname);
 
+  /// @brief Non-throwing version of `get_kernel()`.
+  [[nodiscard]] expected<rtnl_link_t> 
+    try_get_kernel(std::string const& ifname) noexcept;
+
   /// @brief Change a link object.
   /// @param[inout] origin Actual link to change.
   /// @param[in] change Link object containing the changes.
   /// @param[in] flags Optional flags.
-  /// @throws `std::runtime_error` when `rtnl_link_change()` call fails.
+  /// @throws `std::system_error` when `rtnl_link_change()` call fails.
   void link_change(rtnl_link_t& origin, rtnl_link_t& change, int flags = 0);
 
+  /// @brief Non-throwing version of `link_change()`.
+  [[nodiscard]] expected<> 
+    try_link_change(rtnl_link_t& origin, rtnl_link_t& change, int flags = 0) noexcept;
+
+//* No-wait API / / / / / / / / / / / / / / / / / / / / / / / / / / / / / / / /
+
+  /// @brief Queue a `link_change()` without waiting for the kernel ACK.
+  /// @returns The sequence number of the request, or the error.
+  /// @details The kernel error, if any, is reported later by 
+  ///          `collect_errors()` or by the ack handler of `socket()`.
+  [[nodiscard]] expected<uint32_t> 
+    post_link_change(rtnl_link_t& origin, rtnl_link_t& change, int flags = 0) noexcept;
+
+  /// @brief Process the ACKs received so far.
+  /// @returns The errors of the posted requests, keyed by sequence number.
+  /// @throws `std::system_error` when the receive fails.
+  [[nodiscard]] std::vector<nlack_t> collect_errors();
+
+//* Coroutine API / / / / / / / / / / / / / / / / / / / / / / / / / / / / / / /
+
+  /// @brief Connect a second socket and register it with a reactor to enable
+  ///        the `async_*` API.
+  /// @param[in] reactor Reactor that resumes the coroutines. It must outlive 
+  ///            this object, and this object must not move afterwards.
+  /// @throws `std::system_error` when the registration fails.
+  /// @note The libnl helpers behind the blocking API cannot run on a 
+  ///       non-blocking socket, so asynchronous requests use their own.
+  void attach(nlreactor_t& reactor);
+
+  /// @brief Awaitable version of `link_change()`.
+  /// @details The request is built immediately, so the links do not need to
+  ///          outlive the returned task.
+  /// @throws `std::system_error` when the request cannot be built.
+  /// @throws `std::logic_error` if not attached to a reactor.
+  [[nodiscard]] task<> 
+    async_link_change(rtnl_link_t& origin, rtnl_link_t& change, int flags = 0);
+
 private:
 
+  /// @brief Build the `RTM_NEWLINK` request of a link change.
+  [[nodiscard]] static expected<nlmsg_t> 
+    make_link_change(rtnl_link_t& origin, rtnl_link_t& change, int flags) noexcept;
+
+  /// @brief Send a message through the attached reactor and wait for the ACK.
+  [[nodiscard]] task<> async_request(nlmsg_t msg);
+
   nlsocket_t socket_; // to connect to the routing subsystem
+  nlsocket_t async_socket_; // registered with `reactor_` by `attach()`
+  nlreactor_t* reactor_{};  // optional, enables the coroutine API
 };
 
 
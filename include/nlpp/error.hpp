@@ -0,0 +1,93 @@
+#if !defined(NLPP_ERROR_HPP)
+#define NLPP_ERROR_HPP
+
+
+/**
+ * @file error.hpp
+ * Contains the `error` type used by the non-throwing API.
+ */
+
+
+#include <expected>
+#include <string>
+#include <system_error>
+#include <utility>
+
+
+namespace nlpp {
+
+
+/// @brief Error category for libnl error codes (`NLE_*`).
+/// @returns The category singleton. Messages come from `nl_geterror()`.
+[[nodiscard]] std::error_category const& nl_category() noexcept;
+
+
+/**
+ * @brief Structured error returned by the `try_*` non-throwing API.
+ *
+ * @details
+ * Errors reported by the kernel carry their errno in `std::system_category()`;
+ * errors raised by libnl itself carry a `NLE_*` code in `nl_category()`,
+ * which compares equal to the matching `std::errc` value.
+ */
+struct error
+{
+  std::error_code code;   ///< Error code
+  int cmd{};              ///< nl80211 command or rtnetlink message type, if any
+  char const* what{""};   ///< Name of the failed operation
+
+  /// @brief Make an error from a negated errno reported by the kernel.
+  [[nodiscard]] static error from_errno(int err, int cmd = {},
+                                        char const* what = "") noexcept
+  {
+    return {{err < 0 ? -err : err, std::system_category()}, cmd, what};
+  }
+
+  /// @brief Make an error from a negated `NLE_*` code returned by libnl.
+  [[nodiscard]] static error from_nlerr(int err, int cmd = {},
+                                        char const* what = "") noexcept
+  {
+    return {{err < 0 ? -err : err, nl_category()}, cmd, what};
+  }
+
+  /// @brief Returns the errno of the error, e.g. to store it negated.
+  /// @details A `NLE_*` code is mapped to the errno libnl derives it from,
+  ///          or to `EIO` if there is none.
+  [[nodiscard]] int to_errno() const noexcept;
+
+  /// @brief Returns a description of the error.
+  [[nodiscard]] std::string message() const;
+};
+
+
+/// @brief Result of a `try_*` operation.
+template <typename T = void>
+using expected = std::expected<T, error>;
+
+
+/// @brief Throw a `std::system_error` describing an error.
+/// @param[in] err The error to throw.
+[[noreturn]] void throw_error(error const& err);
+
+
+/// @brief Unwrap the value of a `try_*` operation.
+/// @param[in] result Result of the operation.
+/// @returns The contained value.
+/// @throws `std::system_error` when `result` contains an error.
+template <typename T>
+T unwrap(expected<T> result)
+{
+  if(!result) {
+    throw_error(result.error());
+  }
+
+  if constexpr(!std::is_void_v<T>) {
+    return std::move(*result);
+  }
+}
+
+
+};  // end namespace nlpp
+
+
+#endif // NLPP_ERROR_HPP
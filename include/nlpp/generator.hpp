@@ -0,0 +1,172 @@
+#if !defined(NLPP_GENERATOR_HPP)
+#define NLPP_GENERATOR_HPP
+
+
+/**
+ * @file generator.hpp
+ * Contains the `generator` coroutine type definition.
+ */
+
+
+#include <coroutine>
+#include <exception>
+#include <iterator>
+#include <memory>
+#include <utility>
+
+
+namespace nlpp {
+
+
+/**
+ * @brief Synchronous coroutine yielding a sequence of `T`, as an input range.
+ *
+ * @details
+ * A subset of C++23 `std::generator`: the coroutine runs on the consumer
+ * thread each time the iterator is advanced, until its next `co_yield`.
+ * Exceptions thrown inside the coroutine are rethrown by `begin()` or by
+ * `++`. Destroying the generator abandons the rest of the sequence.
+ *
+ * \code
+ * for(auto& info : genl.stream_interfaces()) {
+ *   if(info.if_name == "wlan0") break;
+ * }
+ * \endcode
+ */
+template <typename T>
+class generator
+{
+public:
+
+  /// @brief Coroutine promise type.
+  struct promise_type
+  {
+    generator get_return_object() noexcept
+    {
+      return generator{std::coroutine_handle<promise_type>::from_promise(*this)};
+    }
+
+    std::suspend_always initial_suspend() const noexcept { return {}; }
+    std::suspend_always final_suspend() const noexcept { return {}; }
+
+    /// @note A yielded temporary lives until the coroutine is resumed.
+    std::suspend_always yield_value(T& value) noexcept
+    {
+      value_ = std::addressof(value);
+      return {};
+    }
+
+    std::suspend_always yield_value(T&& value) noexcept
+    {
+      value_ = std::addressof(value);
+      return {};
+    }
+
+    void return_void() const noexcept {}
+
+    void unhandled_exception() noexcept { exception_ = std::current_exception(); }
+
+    /// @brief `co_await` is not allowed in a synchronous generator.
+    template <typename U> std::suspend_never await_transform(U&&) = delete;
+
+    /// @brief Rethrow the exception of the coroutine, if any.
+    void rethrow()
+    {
+      if(exception_) {
+        std::rethrow_exception(std::exchange(exception_, {}));
+      }
+    }
+
+    T* value_{};
+    std::exception_ptr exception_;
+  };
+
+  /// @brief Input iterator over the yielded values.
+  class iterator
+  {
+  public:
+
+    using value_type = T;
+    using difference_type = std::ptrdiff_t;
+
+    iterator() noexcept = default;
+
+    explicit iterator(std::coroutine_handle<promise_type> handle) noexcept
+    : handle_{handle} {}
+
+    T& operator*() const noexcept { return *handle_.promise().value_; }
+
+    iterator& operator++()
+    {
+      handle_.resume();
+      handle_.promise().rethrow();
+
+      return *this;
+    }
+
+    void operator++(int) { ++*this; }
+
+    bool operator==(std::default_sentinel_t) const noexcept
+    {
+      return !handle_ || handle_.done();
+    }
+
+  private:
+
+    std::coroutine_handle<promise_type> handle_;
+  };
+
+  /// @brief Construct an empty generator.
+  generator() = default;
+
+  /// @brief Take ownership of a coroutine.
+  explicit generator(std::coroutine_handle<promise_type> handle) noexcept
+  : handle_{handle} {}
+
+  /// @brief Move ctor.
+  generator(generator&& other) noexcept
+  : handle_{std::exchange(other.handle_, {})} {}
+
+  /// @brief Move assignment operator.
+  /// @returns `*this`.
+  generator& operator=(generator&& rhs) noexcept
+  {
+    generator moved{std::move(rhs)};
+    std::swap(handle_, moved.handle_);
+
+    return *this;
+  }
+
+  /// @brief Destroy the coroutine frame.
+  ~generator()
+  {
+    if(handle_) {
+      handle_.destroy();
+    }
+  }
+
+  /// @brief Run the coroutine until its first value.
+  /// @pre Called once.
+  /// @throws Any exception thrown by the coroutine.
+  [[nodiscard]] iterator begin()
+  {
+    if(handle_) {
+      handle_.resume();
+      handle_.promise().rethrow();
+    }
+
+    return iterator{handle_};
+  }
+
+  [[nodiscard]] std::default_sentinel_t end() const noexcept { return {}; }
+
+private:
+
+  std::coroutine_handle<promise_type> handle_; // owned coroutine
+};
+
+
+};  // end namespace nlpp
+
+
+#endif // NLPP_GENERATOR_HPP
@@ -0,0 +1,150 @@
+#if !defined(GENLFAMILYCACHET_HPP)
+#define GENLFAMILYCACHET_HPP
+
+
+/**
+ * @file genl_family_cache_t.hpp
+ * Contains the `genl_family_cache_t` class definition.
+ */
+
+
+#include "error.hpp"
+#include "nlmsg_view_t.hpp"
+#include "nlsocket_t.hpp"
+
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+
+
+namespace nlpp {
+
+
+/// @brief A generic netlink family, as reported by the controller.
+struct genl_family_t
+{
+  std::string name;       ///< From `CTRL_ATTR_FAMILY_NAME`
+  int id{};               ///< From `CTRL_ATTR_FAMILY_ID`
+  uint32_t version{};     ///< From `CTRL_ATTR_VERSION`
+  uint32_t hdrsize{};     ///< From `CTRL_ATTR_HDRSIZE`
+  uint32_t maxattr{};     ///< From `CTRL_ATTR_MAXATTR`
+  std::map<std::string,uint32_t,std::less<>> groups; ///< Multicast groups by name
+
+  /// @brief Returns the id of a multicast group, if the family has it.
+  [[nodiscard]] std::optional<uint32_t> group(std::string_view name) const
+  {
+    auto found = groups.find(name);
+    if(found == std::end(groups)) {
+      return std::nullopt;
+    }
+
+    return found->second;
+  }
+};
+
+
+/**
+ * @brief Process-wide cache of the resolved generic netlink families.
+ *
+ * @details
+ * `genl_ctrl_resolve()` costs a controller round trip: resolving through
+ * this cache costs it once per family and process, so short-lived
+ * `NetlinkGeneric` objects are cheap.
+ *
+ * The cache listens to the `notify` group of the controller: when a family
+ * is unregistered, registered again (with a new id) or changes its groups,
+ * its entry is dropped before the next lookup. If the subscription fails,
+ * nothing is cached and every lookup is a round trip.
+ *
+ * The cache is thread-safe.
+ */
+class genl_family_cache_t
+{
+public:
+
+  genl_family_cache_t() = default;
+
+  genl_family_cache_t(genl_family_cache_t const&) = delete;
+  genl_family_cache_t& operator=(genl_family_cache_t const&) = delete;
+
+  /// @brief Returns the cache of the process.
+  /// @throws `std::system_error` if its socket cannot be allocated.
+  [[nodiscard]] static genl_family_cache_t& instance();
+
+  /// @brief Returns a family, resolved on a miss.
+  /// @param[in] socket Socket connected to the genl subsystem, which sends
+  ///            the `CTRL_CMD_GETFAMILY` request on a miss.
+  /// @param[in] name Family name, e.g. `"nl80211"`.
+  /// @throws `std::system_error` with `ENOENT` when the family is unknown.
+  [[nodiscard]] genl_family_t resolve(nlsocket_t& socket, std::string_view name);
+
+  /// @brief Non-throwing version of `resolve()`.
+  [[nodiscard]] expected<genl_family_t>
+    try_resolve(nlsocket_t& socket, std::string_view name);
+
+  /// @brief Drop a family, which is resolved again by the next lookup.
+  void invalidate(std::string_view name);
+
+  /// @brief Drop every family.
+  void clear();
+
+  /// @brief Returns the number of controller round trips so far.
+  [[nodiscard]] std::size_t misses() const noexcept;
+
+private:
+
+  /// @brief Subscribe to the controller notifications, once.
+  /// @returns true if the cache can be trusted.
+  /// @pre `mutex_` is held.
+  bool watch() noexcept;
+
+  /// @brief Apply the pending controller notifications.
+  /// @pre `mutex_` is held.
+  void process_events() noexcept;
+
+  /// @brief Returns a counter which changes whenever a notification, or a
+  ///        call to `invalidate()` or `clear()`, may concern a family.
+  /// @details A reply is cached only if the counter of its family did not 
+  ///          change during the round trip.
+  /// @pre `mutex_` is held.
+  [[nodiscard]] uint64_t generation(std::string_view name) const noexcept;
+
+  /// @brief Count a change of a family.
+  /// @pre `mutex_` is held.
+  void bump(std::string_view name) noexcept;
+
+  /// @brief State of a `CTRL_CMD_GETFAMILY` request.
+  struct family_reply_t
+  {
+    genl_family_t family;
+    int err{};  // `ENOMEM` when the reply could not be stored
+  };
+
+  /// @brief Zero-copy callback of a `CTRL_CMD_GETFAMILY` reply.
+  /// @param[in] arg A `family_reply_t`.
+  static int family_handler(nlmsg_view_t msg, void* arg) noexcept;
+
+  /// @brief Zero-copy callback of a controller notification.
+  /// @param[in] arg This cache.
+  static int event_handler(nlmsg_view_t msg, void* arg) noexcept;
+
+//* Representation / / / / / / / / / / / / / / / / / / / / / / / / / / / / / / /
+
+  mutable std::mutex mutex_;  // guards every member below
+  std::map<std::string,genl_family_t,std::less<>> families_;
+  nlsocket_t notify_;         // member of the controller `notify` group
+  std::optional<bool> watching_;  // empty until the first lookup
+  std::size_t misses_{};
+  std::map<std::string,uint64_t,std::less<>> generations_;  // changes by family
+  uint64_t epoch_{};          // changes of every family
+};
+
+
+};  // end namespace nlpp
+
+
+#endif  // GENLFAMILYCACHET_HPP
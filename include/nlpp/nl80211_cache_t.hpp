@@ -0,0 +1,164 @@
+#if !defined(NL80211CACHET_HPP)
+#define NL80211CACHET_HPP
+
+
+/**
+ * @file nl80211_cache_t.hpp
+ * Contains the `nl80211_cache_t` class definition.
+ */
+
+
+#include "error.hpp"
+#include "NetlinkGeneric.hpp"
+#include "nlmsg_view_t.hpp"
+#include "nlpp.hpp"
+#include "nlsocket_t.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string_view>
+#include <vector>
+
+
+namespace nlpp {
+
+
+/// @brief Immutable state of the nl80211 interfaces and phys.
+struct nl80211_state_t
+{
+  std::map<uint32_t,dev_info_t> interfaces;  ///< Key is the interface index
+  std::map<uint32_t,std::shared_ptr<dev_capability_t const>> phys; ///< Key is the wiphy index
+  uint64_t generation{};  ///< Bumped by each published change
+
+  /// @brief Returns an interface, `nullptr` if unknown.
+  [[nodiscard]] dev_info_t const* interface(if_index_t if_index) const noexcept;
+
+  /// @brief Returns an interface by name, `nullptr` if unknown.
+  [[nodiscard]] dev_info_t const* interface(std::string_view if_name) const noexcept;
+
+  /// @brief Returns a phy, `nullptr` if unknown.
+  [[nodiscard]] dev_capability_t const* phy(wiphy_index_t phy_index) const noexcept;
+};
+
+
+/**
+ * @brief Self-updating cache of the nl80211 interfaces and phys.
+ *
+ * @details
+ * The cache takes one dump of the interfaces and phys, then follows the
+ * nl80211 `config` and `mlme` multicast groups: interfaces added, removed or
+ * retyped, channel switches and phys plugged or unplugged are applied as
+ * they are notified, so reads cost no round trip. A phy notification or a
+ * (dis)connection is the only event which costs a request, to fetch what
+ * the notification does not carry.
+ *
+ * One thread, the updater, calls `process_events()` (e.g. when `fd()` is
+ * readable) and `refresh()`. Any thread may read: `snapshot()` returns an
+ * immutable state, which the updater replaces as a whole, so a reader sees
+ * a consistent state and never blocks the updater.
+ *
+ * When the event socket overruns, notifications are lost: the next
+ * `process_events()` takes the dumps again.
+ *
+ * \code
+ * nlpp::nl80211_cache_t cache;
+ * // updater thread
+ * cache.process_events(100ms);
+ * // any thread
+ * auto const state = cache.snapshot();
+ * if(auto* info = state->interface("wlan0")) { ... }
+ * \endcode
+ *
+ * @warning The kernel does not notify the channel of a monitor interface set
+ *          by `NL80211_CMD_SET_WIPHY`: call `refresh(if_index)` after it.
+ */
+class nl80211_cache_t
+{
+public:
+
+  /// @brief Default ctor. Subscribe to the nl80211 groups, then dump.
+  /// @throws `std::system_error` when the subscription or a dump fails.
+  nl80211_cache_t();
+
+  nl80211_cache_t(nl80211_cache_t const&) = delete;
+  nl80211_cache_t& operator=(nl80211_cache_t const&) = delete;
+
+  /// @brief Returns the event socket descriptor.
+  /// @returns A descriptor that becomes readable when events are pending.
+  [[nodiscard]] int fd() const noexcept { return this->events_.fd(); }
+
+  /// @brief Returns the current state.
+  /// @note Thread-safe. The state stays valid as long as it is held.
+  [[nodiscard]] std::shared_ptr<nl80211_state_t const> snapshot() const noexcept
+  {
+    return this->state_.load(std::memory_order_acquire);
+  }
+
+  /// @brief Apply the pending notifications, then publish a new state.
+  /// @param[in] timeout Maximum time to wait for the first notification.
+  /// @returns The number of notifications applied.
+  /// @throws `std::system_error` when a receive or a request fails.
+  std::size_t process_events(std::chrono::milliseconds timeout = {});
+
+  /// @brief Non-throwing version of `process_events()`.
+  [[nodiscard]] expected<std::size_t>
+    try_process_events(std::chrono::milliseconds timeout = {}) noexcept;
+
+  /// @brief Take the dumps again and publish a new state.
+  /// @throws `std::system_error` when a dump fails.
+  void refresh();
+
+  /// @brief Non-throwing version of `refresh()`.
+  [[nodiscard]] expected<> try_refresh() noexcept;
+
+  /// @brief Fetch an interface again and publish a new state.
+  /// @param[in] if_index Interface index.
+  /// @throws `std::system_error` when the request fails.
+  void refresh(if_index_t if_index);
+
+  /// @brief Non-throwing version of `refresh(if_index_t)`.
+  [[nodiscard]] expected<> try_refresh(if_index_t if_index) noexcept;
+
+private:
+
+  /// @brief Returns the working copy of the state, made on the first change.
+  nl80211_state_t& edit();
+
+  /// @brief Fetch an interface into the working copy, or drop it if gone.
+  [[nodiscard]] expected<> try_fetch_interface(if_index_t if_index) noexcept;
+
+  /// @brief Fetch the interfaces and phys marked as stale by the events.
+  [[nodiscard]] expected<> try_fetch_stale() noexcept;
+
+  /// @brief Publish the working copy, if any.
+  void publish() noexcept;
+
+  /// @brief Apply a notification to the working copy.
+  void apply(nlmsg_view_t msg);
+
+  /// @brief Zero-copy callback of a nl80211 notification.
+  /// @param[in] arg This cache.
+  static int event_handler(nlmsg_view_t msg, void* arg) noexcept;
+
+//* Representation / / / / / / / / / / / / / / / / / / / / / / / / / / / / / / /
+
+  NetlinkGeneric genl_;   // dumps and fetches
+  nlsocket_t events_;     // member of the nl80211 `config` and `mlme` groups
+  std::atomic<std::shared_ptr<nl80211_state_t const>> state_; // published
+
+  // updater only
+  std::shared_ptr<nl80211_state_t> working_;  // changes not yet published
+  std::vector<uint32_t> stale_interfaces_;    // to fetch after the events
+  std::vector<uint32_t> stale_phys_;          // to fetch after the events
+  std::size_t applied_{};                     // notifications of this call
+  bool resync_{};                             // notifications were lost
+};
+
+
+};  // end namespace nlpp
+
+
+#endif  // NL80211CACHET_HPP
@@ -0,0 +1,114 @@
+#if !defined(NLATTRINDEXT_HPP)
+#define NLATTRINDEXT_HPP
+
+
+/**
+ * @file nlattr_index_t.hpp
+ * Contains the `nlattr_index_t` class template definition.
+ */
+
+
+#include <netlink/attr.h>
+#include <netlink/genl/genl.h>
+#include <netlink/msg.h>
+
+#include <array>
+#include <cstddef>
+
+
+namespace nlpp {
+
+
+/**
+ * @brief Sparse replacement of `nla_parse()`, which only records the
+ *        attributes a handler declared interest in.
+ *
+ * @tparam Ids Attribute types to record, of any enum (`nl80211_attrs`,
+ *         `nl80211_band_attr`...).
+ *
+ * @details
+ * The attribute stream is walked once, and each attribute type is matched
+ * against `Ids` only: the table holds `sizeof...(Ids)` pointers instead of
+ * `MAX + 1`. As with `nla_parse()`, the last occurrence of a type wins and
+ * no policy is applied. Reading an attribute which was not declared is a
+ * compile error.
+ *
+ * \code
+ * auto const tb = nlattr_index_t<NL80211_ATTR_IFINDEX, NL80211_ATTR_IFNAME>
+ *   ::of_genl(msg);
+ * if(auto* attr = tb.get<NL80211_ATTR_IFINDEX>()) { ... }
+ * \endcode
+ */
+template <auto... Ids>
+class nlattr_index_t
+{
+public:
+
+  /// @brief Index an attribute stream.
+  /// @param[in] head First attribute.
+  /// @param[in] len Length of the stream in bytes.
+  nlattr_index_t(struct nlattr* head, int len) noexcept
+  {
+    struct nlattr* attr;
+    int rem;
+
+    nla_for_each_attr(attr, head, len, rem) {
+      this->record(nla_type(attr), attr);
+    }
+  }
+
+  /// @brief Index the attributes of a generic netlink message.
+  [[nodiscard]] static nlattr_index_t of_genl(struct nl_msg* msg) noexcept
+  {
+    auto* gnlh = reinterpret_cast<struct genlmsghdr*>(nlmsg_data(nlmsg_hdr(msg)));
+
+    return {genlmsg_attrdata(gnlh, 0), genlmsg_attrlen(gnlh, 0)};
+  }
+
+  /// @brief Index the attributes nested in an attribute.
+  [[nodiscard]] static nlattr_index_t of_nested(struct nlattr* nest) noexcept
+  {
+    return {reinterpret_cast<struct nlattr*>(nla_data(nest)), nla_len(nest)};
+  }
+
+  /// @brief Returns the attribute of type `Id`, `nullptr` if missing.
+  template <auto Id>
+  [[nodiscard]] struct nlattr* get() const noexcept
+  {
+    return attrs_[position<Id>()];
+  }
+
+private:
+
+  /// @brief Returns the position of `Id` in `Ids`.
+  template <auto Id>
+  static consteval std::size_t position()
+  {
+    constexpr std::array<int, sizeof...(Ids)> ids{static_cast<int>(Ids)...};
+
+    std::size_t pos = 0;
+    while(pos != ids.size() && ids[pos] != static_cast<int>(Id)) {
+      ++pos;
+    }
+
+    // not a constant expression: `Id` was not declared
+    return pos != ids.size() ? pos : throw "attribute not indexed";
+  }
+
+  /// @brief Store an attribute, if its type is one of `Ids`.
+  void record(int type, struct nlattr* attr) noexcept
+  {
+    std::size_t pos = 0;
+
+    (void)((type == static_cast<int>(Ids) ? (attrs_[pos] = attr, true)
+                                          : (++pos, false)) || ...);
+  }
+
+  std::array<struct nlattr*, sizeof...(Ids)> attrs_{};
+};
+
+
+};  // end namespace nlpp
+
+
+#endif  // NLATTRINDEXT_HPP
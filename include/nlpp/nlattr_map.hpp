@@ -0,0 +1,305 @@
+#if !defined(NLATTRMAP_HPP)
+#define NLATTRMAP_HPP
+
+
+/**
+ * @file nlattr_map.hpp
+ * Contains the declarative struct <- attributes mapping, which generates the
+ * parsers of the nl80211 replies.
+ */
+
+
+#include "nlattr_schema.hpp"
+#include "nlmsg_view_t.hpp"
+
+#include <netlink/attr.h>
+#include <netlink/genl/genl.h>
+#include <netlink/msg.h>
+
+#include <bitset>
+#include <concepts>
+#include <cstddef>
+#include <cstring>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+
+namespace nlpp {
+
+
+//* Decoders / / / / / / / / / / / / / / / / / / / / / / / / / / / / / / / / /
+
+/// @brief Read the payload of an attribute as the wire type `Wire`.
+/// @returns The value, or `std::nullopt` if the payload is too short.
+template <typename Wire>
+[[nodiscard]] std::optional<Wire> nla_read(struct nlattr* attr) noexcept
+{
+  auto const* data = reinterpret_cast<char const*>(nla_data(attr));
+  auto const len = static_cast<std::size_t>(nla_len(attr));
+
+  if constexpr(std::same_as<Wire, std::string_view>) {
+    return std::string_view{data, ::strnlen(data, len)};
+  }
+  else if constexpr(std::same_as<Wire, std::span<std::byte const>>) {
+    return std::span{reinterpret_cast<std::byte const*>(data), len};
+  }
+  else
+  {
+    if(len < sizeof(Wire)) {
+      return std::nullopt;
+    }
+
+    Wire value;
+    std::memcpy(&value, data, sizeof(Wire));
+    return value;
+  }
+}
+
+
+/// @brief Trait for `std::optional` fields.
+template <typename T> struct is_optional : std::false_type {};
+template <typename T> struct is_optional<std::optional<T>> : std::true_type {};
+
+
+/// @brief Store a wire value into a field, unwrapping `std::optional`.
+template <typename Field, typename Wire>
+void nla_assign(Field& field, Wire const& value)
+{
+  if constexpr(is_optional<Field>::value) {
+    field.emplace(static_cast<typename Field::value_type>(value));
+  }
+  else {
+    field = static_cast<Field>(value);
+  }
+}
+
+
+/**
+ * @brief Default decoder: the payload is read with its `nl80211_attr_traits`
+ *        wire type, or with `Wire` if given, and converted to the field.
+ */
+template <typename Wire = void>
+struct nldecode_t
+{
+  template <auto Attr, typename Field>
+  static void decode(struct nlattr* attr, Field& field)
+  {
+    // lazy: `Attr` may be of another enum when `Wire` is given
+    using wire_t = typename std::conditional_t<std::is_void_v<Wire>,
+      nl80211_attr_traits<static_cast<nl80211_attrs>(Attr)>,
+      std::type_identity<Wire>>::type;
+
+    if(auto value = nla_read<wire_t>(attr)) {
+      nla_assign(field, *value);
+    }
+  }
+};
+
+
+/// @brief Decoder of a `Wire` value appended to a `std::vector` field.
+template <typename Wire>
+struct nldecode_append_t
+{
+  template <auto Attr, typename T>
+  static void decode(struct nlattr* attr, std::vector<T>& field)
+  {
+    if(auto value = nla_read<Wire>(attr)) {
+      field.push_back(static_cast<T>(*value));
+    }
+  }
+};
+
+
+/// @brief Decoder of the attribute type, appended to a `std::vector` field.
+struct nldecode_type_t
+{
+  template <auto Attr, typename T>
+  static void decode(struct nlattr* attr, std::vector<T>& field)
+  {
+    field.push_back(static_cast<T>(nla_type(attr)));
+  }
+};
+
+
+/// @brief Decoder of a `Wire` value, set as a bit of a `std::bitset` field.
+/// @details Values beyond the bitset are ignored.
+template <typename Wire>
+struct nldecode_bit_t
+{
+  template <auto Attr, std::size_t N>
+  static void decode(struct nlattr* attr, std::bitset<N>& field)
+  {
+    if(auto value = nla_read<Wire>(attr); value && *value < N) {
+      field.set(static_cast<std::size_t>(*value));
+    }
+  }
+};
+
+
+/// @brief Decoder of the attribute type, set as a bit of a `std::bitset`.
+struct nldecode_type_bit_t
+{
+  template <auto Attr, std::size_t N>
+  static void decode(struct nlattr* attr, std::bitset<N>& field)
+  {
+    if(auto const type = static_cast<std::size_t>(nla_type(attr)); type < N) {
+      field.set(type);
+    }
+  }
+};
+
+
+/// @brief Decoder of a binary payload into a `std::string` field, e.g. SSID.
+struct nldecode_bytes_t
+{
+  template <auto Attr>
+  static void decode(struct nlattr* attr, std::string& field)
+  {
+    field.assign(reinterpret_cast<char const*>(nla_data(attr)), nla_len(attr));
+  }
+};
+
+
+/// @brief Decoder of a MAC address into a `aa:bb:cc:dd:ee:ff` string field.
+struct nldecode_mac_t
+{
+  template <auto Attr>
+  static void decode(struct nlattr* attr, std::string& field)
+  {
+    static constexpr char digits[] = "0123456789abcdef";
+    auto const* data = reinterpret_cast<unsigned char const*>(nla_data(attr));
+
+    field.clear();
+    for(int i = 0; i != nla_len(attr); ++i)
+    {
+      if(i) {
+        field.push_back(':');
+      }
+      field.push_back(digits[data[i] >> 4]);
+      field.push_back(digits[data[i] & 0x0f]);
+    }
+  }
+};
+
+
+/// @brief Decoder applying `Decoder` to each element of a nested list, e.g.
+///        `NL80211_ATTR_SUPPORTED_COMMANDS` or the bands of a wiphy.
+template <typename Decoder>
+struct nldecode_each_t
+{
+  template <auto Attr, typename Field>
+  static void decode(struct nlattr* attr, Field& field)
+  {
+    struct nlattr* item;
+    int rem;
+
+    nla_for_each_nested(item, attr, rem) {
+      Decoder::template decode<Attr>(item, field);
+    }
+  }
+};
+
+
+/// @brief Decoder of a nested path step: the `Inner` attribute of the nest
+///        is decoded by `Decoder`.
+template <auto Inner, typename Decoder>
+struct nldecode_path_t
+{
+  template <auto Attr, typename Field>
+  static void decode(struct nlattr* attr, Field& field)
+  {
+    struct nlattr* item;
+    int rem;
+
+    nla_for_each_nested(item, attr, rem) 
+    {
+      if(nla_type(item) == static_cast<int>(Inner)) {
+        Decoder::template decode<Inner>(item, field);
+      }
+    }
+  }
+};
+
+
+//* Mapping / / / / / / / / / / / / / / / / / / / / / / / / / / / / / / / / / /
+
+/// @brief Declare "field `Member` <- attribute `Attr`, decoded by `Decoder`".
+template <auto Attr, auto Member, typename Decoder = nldecode_t<>>
+struct nlfield_t
+{
+  static constexpr int type = static_cast<int>(Attr);
+
+  template <typename Struct>
+  static void decode(struct nlattr* attr, Struct& out)
+  {
+    Decoder::template decode<Attr>(attr, out.*Member);
+  }
+};
+
+
+/**
+ * @brief Parser generated from a list of `nlfield_t`.
+ *
+ * @details
+ * The attribute stream is walked once and each attribute is dispatched to
+ * the fields mapped to its type: no table is built, and fields of missing
+ * attributes are left untouched (`std::optional` ones stay empty). Adding
+ * a field is adding an `nlfield_t` to the list.
+ *
+ * \code
+ * using dev_info_map = nlattr_map_t<dev_info_t,
+ *   nlfield_t<NL80211_ATTR_IFNAME, &dev_info_t::if_name>,
+ *   nlfield_t<NL80211_ATTR_WIPHY_FREQ, &dev_info_t::wiphy_freq>>;
+ *
+ * dev_info_map::parse_genl(msg, dev_info);
+ * \endcode
+ */
+template <typename Struct, typename... Fields>
+struct nlattr_map_t
+{
+  /// @brief Decode an attribute stream into `out`.
+  static void parse(struct nlattr* head, int len, Struct& out)
+  {
+    struct nlattr* attr;
+    int rem;
+
+    nla_for_each_attr(attr, head, len, rem)
+    {
+      int const type = nla_type(attr);
+      (void)((type == Fields::type ? (Fields::decode(attr, out), 0) : 0), ...);
+    }
+  }
+
+  /// @brief Decode the attributes of a generic netlink message into `out`.
+  static void parse_genl(struct nl_msg* msg, Struct& out)
+  {
+    auto* gnlh = reinterpret_cast<struct genlmsghdr*>(nlmsg_data(nlmsg_hdr(msg)));
+
+    parse(genlmsg_attrdata(gnlh, 0), genlmsg_attrlen(gnlh, 0), out);
+  }
+
+  /// @brief Decode the attributes of a generic netlink message in place.
+  static void parse_genl(nlmsg_view_t msg, Struct& out)
+  {
+    auto const payload = msg.payload();
+    if(payload.size() < GENL_HDRLEN) {
+      return;
+    }
+
+    // libnl walks attributes through non-const pointers, but only reads them
+    auto* head = const_cast<std::byte*>(payload.data() + GENL_HDRLEN);
+
+    parse(reinterpret_cast<struct nlattr*>(head), 
+          static_cast<int>(payload.size() - GENL_HDRLEN), out);
+  }
+};
+
+
+};  // end namespace nlpp
+
+
+#endif  // NLATTRMAP_HPP
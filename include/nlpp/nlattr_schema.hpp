@@ -0,0 +1,125 @@
+#if !defined(NLATTRSCHEMA_HPP)
+#define NLATTRSCHEMA_HPP
+
+
+/**
+ * @file nlattr_schema.hpp
+ * Contains the compile-time wire types of the nl80211 attributes.
+ */
+
+
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string_view>
+#include <type_traits>
+
+#include <linux/nl80211.h>
+
+
+namespace nlpp {
+
+
+/// @brief Wire type of the `NLA_FLAG` attributes, which have no payload.
+struct nlflag_t {};
+
+
+/**
+ * @brief Wire type of a nl80211 attribute, as declared by the kernel policy.
+ *
+ * @details
+ * Only mapped attributes can be put with `nlmsg_t::put<Attr>()`: an unmapped
+ * one is a compile error. Map a new attribute by specializing this template
+ * with its wire type (a fixed-width unsigned integer, `std::string_view` for
+ * `NLA_NUL_STRING`, `std::span<std::byte const>` for `NLA_BINARY` or 
+ * `nlflag_t`). Nested attributes are opened with `nlmsg_t::nest()`.
+ *
+ * The schema is deliberately a subset of `enum nl80211_attrs`: the attributes
+ * of the requests this library builds (interfaces, wiphy identity and radio
+ * settings, dump flags) and of the management frame commands which monitor
+ * mode tools issue. The wire types are copied from the `nla_policy` of 
+ * `net/wireless/nl80211.c`, which the uapi header does not carry, so each
+ * entry is added with a user rather than guessed in bulk. Other attributes
+ * are put with the untyped `put_attr()`, `put_string()` and `put_binary()`.
+ */
+template <nl80211_attrs Attr>
+struct nl80211_attr_traits;
+
+
+/// @brief Shortcut for `nl80211_attr_traits<Attr>::type`.
+template <nl80211_attrs Attr>
+using nl80211_attr_type_t = typename nl80211_attr_traits<Attr>::type;
+
+
+/// @brief Concept for a value that encodes as the attribute `Attr`.
+/// @details Integers must match the wire type exactly, so a narrowing or
+///          sign change is a compile error rather than a silent conversion.
+template <typename Type, nl80211_attrs Attr>
+concept is_nl80211_value =
+  (std::same_as<nl80211_attr_type_t<Attr>, std::string_view>
+    && std::convertible_to<Type const&, std::string_view>)
+  || (std::same_as<nl80211_attr_type_t<Attr>, std::span<std::byte const>>
+    && std::convertible_to<Type const&, std::span<std::byte const>>)
+  || (std::unsigned_integral<nl80211_attr_type_t<Attr>>
+    && std::same_as<std::remove_cvref_t<Type>, nl80211_attr_type_t<Attr>>);
+
+
+/// @brief Concept for a flag attribute.
+template <nl80211_attrs Attr>
+concept is_nl80211_flag = std::same_as<nl80211_attr_type_t<Attr>, nlflag_t>;
+
+
+//* Schema / / / / / / / / / / / / / / / / / / / / / / / / / / / / / / / / / / /
+
+#define NLPP_NL80211_ATTR(attr, wire) \
+  template <> struct nl80211_attr_traits<attr> { using type = wire; }
+
+// interfaces and phys
+NLPP_NL80211_ATTR(NL80211_ATTR_WIPHY, uint32_t);
+NLPP_NL80211_ATTR(NL80211_ATTR_WIPHY_NAME, std::string_view);
+NLPP_NL80211_ATTR(NL80211_ATTR_IFINDEX, uint32_t);
+NLPP_NL80211_ATTR(NL80211_ATTR_IFNAME, std::string_view);
+NLPP_NL80211_ATTR(NL80211_ATTR_IFTYPE, uint32_t);
+NLPP_NL80211_ATTR(NL80211_ATTR_WDEV, uint64_t);
+NLPP_NL80211_ATTR(NL80211_ATTR_MAC, std::span<std::byte const>);
+NLPP_NL80211_ATTR(NL80211_ATTR_SSID, std::span<std::byte const>);
+NLPP_NL80211_ATTR(NL80211_ATTR_IE, std::span<std::byte const>);
+NLPP_NL80211_ATTR(NL80211_ATTR_GENERATION, uint32_t);
+NLPP_NL80211_ATTR(NL80211_ATTR_4ADDR, uint8_t);
+
+// channel and radio settings of `NL80211_CMD_SET_WIPHY`
+NLPP_NL80211_ATTR(NL80211_ATTR_WIPHY_FREQ, uint32_t);
+NLPP_NL80211_ATTR(NL80211_ATTR_WIPHY_FREQ_OFFSET, uint32_t);
+NLPP_NL80211_ATTR(NL80211_ATTR_WIPHY_CHANNEL_TYPE, uint32_t);
+NLPP_NL80211_ATTR(NL80211_ATTR_CHANNEL_WIDTH, uint32_t);
+NLPP_NL80211_ATTR(NL80211_ATTR_CENTER_FREQ1, uint32_t);
+NLPP_NL80211_ATTR(NL80211_ATTR_CENTER_FREQ2, uint32_t);
+NLPP_NL80211_ATTR(NL80211_ATTR_WIPHY_TX_POWER_SETTING, uint32_t);
+NLPP_NL80211_ATTR(NL80211_ATTR_WIPHY_TX_POWER_LEVEL, uint32_t);
+NLPP_NL80211_ATTR(NL80211_ATTR_WIPHY_RETRY_SHORT, uint8_t);
+NLPP_NL80211_ATTR(NL80211_ATTR_WIPHY_RETRY_LONG, uint8_t);
+NLPP_NL80211_ATTR(NL80211_ATTR_WIPHY_FRAG_THRESHOLD, uint32_t);
+NLPP_NL80211_ATTR(NL80211_ATTR_WIPHY_RTS_THRESHOLD, uint32_t);
+NLPP_NL80211_ATTR(NL80211_ATTR_WIPHY_COVERAGE_CLASS, uint8_t);
+
+// management frames: `NL80211_CMD_FRAME` and `NL80211_CMD_REGISTER_FRAME`
+NLPP_NL80211_ATTR(NL80211_ATTR_FRAME, std::span<std::byte const>);
+NLPP_NL80211_ATTR(NL80211_ATTR_FRAME_MATCH, std::span<std::byte const>);
+NLPP_NL80211_ATTR(NL80211_ATTR_FRAME_TYPE, uint16_t);
+NLPP_NL80211_ATTR(NL80211_ATTR_COOKIE, uint64_t);
+NLPP_NL80211_ATTR(NL80211_ATTR_DURATION, uint32_t);
+NLPP_NL80211_ATTR(NL80211_ATTR_OFFCHANNEL_TX_OK, nlflag_t);
+NLPP_NL80211_ATTR(NL80211_ATTR_DONT_WAIT_FOR_ACK, nlflag_t);
+
+// request flags
+NLPP_NL80211_ATTR(NL80211_ATTR_SPLIT_WIPHY_DUMP, nlflag_t);
+NLPP_NL80211_ATTR(NL80211_ATTR_SOCKET_OWNER, nlflag_t);
+
+#undef NLPP_NL80211_ATTR
+
+
+};  // end namespace nlpp
+
+
+#endif  // NLATTRSCHEMA_HPP
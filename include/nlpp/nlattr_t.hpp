@@ -9,7 +9,9 @@
 
 
 #include <concepts>
+#include <cstddef>
 #include <cstdint>
+#include <span>
 #include <string>
 #include <variant>
 
@@ -20,8 +22,10 @@ namespace nlpp {
 
 
 /// @brief Variant for all Netlink attribute types for a message.
-using nlattr_val_t 
-  = std::variant<uint8_t,uint16_t,uint32_t,uint64_t,std::string>;
+/// @details A `std::span` payload is put as it is, without copy: the bytes
+///          must outlive the `nlattr_t`. An empty one encodes a flag.
+using nlattr_val_t = std::variant<uint8_t,uint16_t,uint32_t,uint64_t,
+                                  std::string,std::span<std::byte const>>;
 
 
 /// @brief Netlink Attribute struct definition.
@@ -0,0 +1,201 @@
+#if !defined(NLCACHEMNGRT_HPP)
+#define NLCACHEMNGRT_HPP
+
+
+/**
+ * @file nlcache_mngr_t.hpp
+ * Contains the `nlcache_mngr_t` class definition.
+ */
+
+
+#include "error.hpp"
+#include "nlsocket_t.hpp"
+#include "rtnl_link_t.hpp"
+
+#include <netlink/cache.h>
+#include <netlink/route/link.h>
+
+#include <chrono>
+#include <functional>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+
+namespace nlpp {
+
+
+/// @brief Change of a cached object.
+/// @note From the `NL_ACT_*` actions of `<netlink/cache.h>`.
+enum class cache_action_e
+{
+  add     = NL_ACT_NEW,
+  del     = NL_ACT_DEL,
+  change  = NL_ACT_CHANGE
+};
+
+
+/// @brief Callback of a link change, invoked by `nlcache_mngr_t::poll()`.
+/// @note It must not throw.
+using link_change_handler_t = std::function<void(cache_action_e, rtnl_link_t&)>;
+
+
+/**
+ * @brief Link cache which follows the kernel, built on `struct nl_cache_mngr`.
+ *
+ * @details
+ * Unlike `nlcache_t`, which is a one-shot dump, the cache is subscribed to
+ * `RTNLGRP_LINK`: `poll()`, or `data_ready()` when `fd()` is readable,
+ * applies the notifications and reports each one to the change handler.
+ * Lookups by index and by name are hash lookups on the live cache, with no
+ * round trip.
+ *
+ * When the notification socket overruns, the cache is resynchronised with
+ * a dump and the differences are reported as changes.
+ *
+ * \code
+ * nlpp::nlcache_mngr_t links;
+ * links.set_change_handler([](nlpp::cache_action_e action, auto& link) { ... });
+ * links.poll(100ms);
+ * auto wlan0 = links.get_link("wlan0");
+ * \endcode
+ *
+ * @warning Not thread-safe: lookups must run on the thread which polls.
+ * @see https://www.infradead.org/~tgr/libnl/doc/core.html#_cache_manager
+ */
+class nlcache_mngr_t
+{
+public:
+
+  /// @brief Construct the manager and its link cache, filled by a dump.
+  /// @param[in] family Address family to use.
+  /// @throws `std::system_error` when the manager or the cache fails.
+  explicit nlcache_mngr_t(int family = AF_UNSPEC);
+
+  nlcache_mngr_t(nlcache_mngr_t const&) = delete;
+  nlcache_mngr_t& operator=(nlcache_mngr_t const&) = delete;
+
+  /// @brief Release the manager, its cache and the indexed links.
+  ~nlcache_mngr_t();
+
+  /// @brief Return the pointer to the managed object.
+  [[nodiscard]] struct nl_cache_mngr* get_pointer() const noexcept
+  {
+    return this->mngrPtr_;
+  }
+
+  /// @brief Return the pointer to the live link cache.
+  [[nodiscard]] struct nl_cache* cache() const noexcept { return this->cachePtr_; }
+
+  /// @brief Returns the notification socket descriptor.
+  /// @returns A descriptor that becomes readable when notifications are
+  ///          pending: then call `data_ready()`.
+  [[nodiscard]] int fd() const noexcept;
+
+  /// @brief Set the handler invoked for each change of a link.
+  void set_change_handler(link_change_handler_t handler) noexcept
+  {
+    this->handler_ = std::move(handler);
+  }
+
+//* Updates / / / / / / / / / / / / / / / / / / / / / / / / / / / / / / / / / /
+
+  /// @brief Wait for notifications and apply them.
+  /// @param[in] timeout Maximum time to wait.
+  /// @returns The number of notifications applied.
+  /// @throws `std::system_error` when the receive fails.
+  std::size_t poll(std::chrono::milliseconds timeout);
+
+  /// @brief Non-throwing version of `poll()`.
+  [[nodiscard]] expected<std::size_t>
+    try_poll(std::chrono::milliseconds timeout) noexcept;
+
+  /// @brief Apply the pending notifications, without waiting.
+  /// @returns The number of notifications applied.
+  /// @throws `std::system_error` when the receive fails.
+  std::size_t data_ready();
+
+  /// @brief Non-throwing version of `data_ready()`.
+  [[nodiscard]] expected<std::size_t> try_data_ready() noexcept;
+
+  /// @brief Dump the links again and report the differences.
+  /// @throws `std::system_error` when the dump fails.
+  void resync();
+
+  /// @brief Non-throwing version of `resync()`.
+  [[nodiscard]] expected<> try_resync() noexcept;
+
+//* Lookups / / / / / / / / / / / / / / / / / / / / / / / / / / / / / / / / / /
+
+  /// @brief Returns the number of cached links.
+  [[nodiscard]] std::size_t size() const noexcept { return this->by_index_.size(); }
+
+  /// @brief Retrieve a `rtnl_link_t`.
+  /// @returns A `rtnl_link_t` object if found.
+  [[nodiscard]] std::optional<rtnl_link_t> get_link(if_index_t ifindex) const;
+
+  /// @brief Retrieve a `rtnl_link_t`.
+  /// @param[in] ifname The interface name.
+  /// @returns A `rtnl_link_t` object if found.
+  [[nodiscard]] std::optional<rtnl_link_t> get_link(std::string_view ifname) const;
+
+  /// @brief Retrieve the interface name from his index.
+  /// @returns The interface name or a empty string.
+  [[nodiscard]] std::string i2name(if_index_t ifindex) const;
+
+  /// @brief Retrieve the interface index from his name.
+  /// @returns The interface index, if found.
+  [[nodiscard]] std::optional<if_index_t> name2i(std::string_view ifname) const;
+
+private:
+
+  /// @brief Update the indexes with a change of the cache.
+  void index(struct rtnl_link* linkPtr, cache_action_e action);
+
+  /// @brief Rebuild the indexes from the cache.
+  void reindex();
+
+  /// @brief Rebuild the indexes if an update could not be indexed.
+  [[nodiscard]] expected<> try_repair() noexcept;
+
+  /// @brief `change_func_t` of the cache: index, then report a change.
+  /// @param[in] arg This manager.
+  static void change_handler(struct nl_cache*, struct nl_object* obj,
+                             int action, void* arg) noexcept;
+
+  /// @brief Indexed link.
+  struct entry_t
+  {
+    struct rtnl_link* linkPtr;  // a reference
+    std::string name;           // when indexed: libnl updates links in place
+  };
+
+  /// @brief Transparent hash of the names, to look up a `std::string_view`.
+  struct name_hash_t
+  {
+    using is_transparent = void;
+
+    std::size_t operator()(std::string_view name) const noexcept
+    {
+      return std::hash<std::string_view>{}(name);
+    }
+  };
+
+//* Representation / / / / / / / / / / / / / / / / / / / / / / / / / / / / / / /
+
+  struct nl_cache_mngr* mngrPtr_{};  // owns its sockets and `cachePtr_`
+  struct nl_cache* cachePtr_{};      // live link cache
+  nlsocket_t sync_;                  // dumps of `resync()`
+  link_change_handler_t handler_;    // optional
+  bool stale_{};                     // an update was not indexed
+
+  std::unordered_map<uint32_t,entry_t> by_index_;
+  std::unordered_map<std::string,uint32_t,name_hash_t,std::equal_to<>> by_name_;
+};
+
+
+};  // end namespace nlpp
+
+
+#endif  // NLCACHEMNGRT_HPP
@@ -23,6 +23,7 @@ namespace nlpp {
  * This object represent a list of links in the kernel.
  * 
  * @see https://www.infradead.org/~tgr/libnl/doc/route.html#_get_list
+ * @see `nlcache_mngr_t` for a cache which follows the kernel.
  */
 class nlcache_t
 {
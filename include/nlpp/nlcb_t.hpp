@@ -34,6 +34,11 @@ public:
   /// @throws `std::system_error` with code ENOMEM.
   nlcb_t(enum nl_cb_kind kind);
 
+  /// @brief Take ownership of an existing `struct nl_cb` reference.
+  /// @throws `std::logic_error` if `ptr` is `nullptr`.
+  /// @note The reference is released with `nl_cb_put()` on destruction, so 
+  ///       pass a pointer obtained with `nl_cb_get()` or `nl_socket_get_cb()`.
+  explicit nlcb_t(struct nl_cb*);
 
   /// @brief Move ctor.
   nlcb_t(nlcb_t&&) noexcept;
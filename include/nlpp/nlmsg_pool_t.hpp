@@ -0,0 +1,91 @@
+#if !defined(NLMSGPOOLT_HPP)
+#define NLMSGPOOLT_HPP
+
+
+/** 
+ * @file nlmsg_pool_t.hpp
+ * Contains the `nlmsg_pool_t` class definition.
+ */
+
+
+#include <netlink/msg.h>
+
+#include <cstddef>
+#include <vector>
+
+
+namespace nlpp {
+
+
+/**
+ * @brief Cache of reset `struct nl_msg` buffers, recycled by `nlmsg_t`.
+ *
+ * @details
+ * A `nlmsg_t` created from a pool takes a cached buffer, if any, and gives it
+ * back on destruction instead of freeing it: once warm, building a request 
+ * costs no `malloc()`/`free()`. Buffers beyond `capacity()` are freed.
+ *
+ * A pool is not thread-safe: use one per thread (e.g. `local()`) or per
+ * object. Messages must be destroyed before their pool, on its thread.
+ */
+class nlmsg_pool_t
+{
+public:
+
+  /// @brief Default number of cached buffers.
+  static constexpr std::size_t default_capacity = 8;
+
+  /// @brief Construct an empty pool.
+  /// @param[in] msg_size Buffer size, passed to `nlmsg_alloc_size()`. The
+  ///            libnl default size (a page) if zero.
+  /// @param[in] capacity Maximum number of cached buffers.
+  /// @throws `std::bad_alloc` if the cache cannot be reserved.
+  explicit nlmsg_pool_t(std::size_t msg_size = 0, 
+                        std::size_t capacity = default_capacity);
+
+  nlmsg_pool_t(nlmsg_pool_t const&) = delete;
+  nlmsg_pool_t& operator=(nlmsg_pool_t const&) = delete;
+
+  /// @brief Free the cached buffers.
+  ~nlmsg_pool_t();
+
+  /// @brief Returns the pool of the calling thread, with the default sizes.
+  [[nodiscard]] static nlmsg_pool_t& local() noexcept;
+
+  /// @brief Returns the size of the buffers, `0` for the libnl default.
+  [[nodiscard]] std::size_t msg_size() const noexcept { return msg_size_; }
+
+  /// @brief Returns the maximum number of cached buffers.
+  [[nodiscard]] std::size_t capacity() const noexcept { return capacity_; }
+
+  /// @brief Returns the number of cached buffers.
+  [[nodiscard]] std::size_t size() const noexcept { return free_.size(); }
+
+  /// @brief Allocate buffers until `count` are cached, up to `capacity()`.
+  /// @returns False if an allocation failed.
+  bool prefill(std::size_t count) noexcept;
+
+  /// @brief Take a reset buffer, or allocate one if the cache is empty.
+  /// @returns The buffer, or `nullptr` if the allocation failed.
+  [[nodiscard]] struct nl_msg* acquire() noexcept;
+
+  /// @brief Reset a buffer and cache it, or free it if the cache is full.
+  void release(struct nl_msg* msgPtr) noexcept;
+
+private:
+
+  /// @brief Allocate a buffer of `msg_size_`.
+  [[nodiscard]] struct nl_msg* allocate() const noexcept;
+
+//* Representation / / / / / / / / / / / / / / / / / / / / / / / / / / / / / / / 
+
+  std::vector<struct nl_msg*> free_; // cached buffers, never reallocated
+  std::size_t msg_size_{};           // `0` for `nlmsg_alloc()`
+  std::size_t capacity_{};           // maximum size of `free_`
+};
+
+
+};  // end namespace nlpp
+
+
+#endif  // NLMSGPOOLT_HPP
@@ -8,18 +8,63 @@
  */
  
 
+#include "error.hpp"
+#include "nlattr_schema.hpp"
 #include "nlattr_t.hpp"
+#include "nlmsg_pool_t.hpp"
 
 #include <linux/nl80211.h>
 #include <netlink/msg.h>
 
 #include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <string_view>
 #include <utility>
 
 
 namespace nlpp {
 
 
+class nlnest_t;
+
+
+/**
+ * @brief Handle to the payload of a fixed-size attribute of a prebuilt 
+ *        message, to patch it in place before sending the message again.
+ *
+ * @details Valid as long as the message, even if the `nlmsg_t` is moved.
+ */
+template <typename T> requires std::is_trivially_copyable_v<T>
+class nlslot_t
+{
+public:
+
+  /// @brief Default ctor. An unbound slot.
+  nlslot_t() noexcept = default;
+
+  /// @brief Bind the slot to an attribute payload of `sizeof(T)` bytes.
+  explicit nlslot_t(std::byte* data) noexcept : data_{data} {}
+
+  /// @brief Overwrite the attribute value.
+  void set(T const& value) noexcept { std::memcpy(data_, &value, sizeof(T)); }
+
+  /// @brief Returns the attribute value.
+  [[nodiscard]] T get() const noexcept
+  {
+    T value;
+    std::memcpy(&value, data_, sizeof(T));
+    return value;
+  }
+
+private:
+
+  std::byte* data_{}; // payload inside the message buffer
+};
+
+
 /** 
  * @brief Simple C++ wrapper around a `struct nl_msg` with RAII.
  */
@@ -37,6 +82,35 @@ public:
   /// @param[in] flags Flags to append.
   nlmsg_t(int family, nl80211_commands cmd, int flags=0);
 
+  /// @brief Create an empty netlink message from a pool.
+  /// @param[in] pool Pool the buffer is taken from and given back to. It
+  ///            must outlive the message.
+  /// @throws `std::system_error` with `ENOMEM` errno code.
+  explicit nlmsg_t(nlmsg_pool_t& pool);
+
+  /// @brief Create a netlink message from a pool and put a genl header.
+  nlmsg_t(nlmsg_pool_t& pool, int family, nl80211_commands cmd, int flags=0);
+
+  /// @brief Take ownership of an existing `struct nl_msg`.
+  /// @throws `std::logic_error` if `ptr` is `nullptr`.
+  /// @note Used to wrap messages built by libnl, e.g. by 
+  ///       `rtnl_link_build_change_request()`.
+  explicit nlmsg_t(struct nl_msg*);
+
+  /// @brief Non-throwing version of the genl header ctor.
+  /// @returns The message, or `ENOMEM`/the `genlmsg_put()` error.
+  [[nodiscard]] static expected<nlmsg_t> 
+    try_create(int family, nl80211_commands cmd, int flags = 0) noexcept;
+
+  /// @brief Non-throwing version of the pool genl header ctor.
+  [[nodiscard]] static expected<nlmsg_t> try_create(
+    nlmsg_pool_t& pool, int family, nl80211_commands cmd, int flags = 0) noexcept;
+
+  /// @brief Non-throwing version of the genl header ctor, for the commands 
+  ///        of another family, e.g. `CTRL_CMD_GETFAMILY` of the controller.
+  [[nodiscard]] static expected<nlmsg_t> 
+    try_create(int family, uint8_t cmd, int flags = 0) noexcept;
+
   /// @brief Move ctor.
   nlmsg_t(nlmsg_t&&) noexcept;
 
@@ -44,7 +118,7 @@ public:
   /// @returns `*this`.
   nlmsg_t& operator=(nlmsg_t&&) noexcept;
 
-  /// @brief Free the underlying resource.
+  /// @brief Free the underlying resource, or give it back to its pool.
   ~nlmsg_t();
 
   /// @brief Return the underlying pointer.
@@ -54,8 +128,60 @@ public:
 //* libnl api / / / / / / / / / / / / / / / / / / / / / / / / / / / / / / / / / 
 
   /// @brief Put attribute into the message.
-  /// @throw `std::runtime_error` When `nla_put_*()` call fail.
+  /// @throw `std::system_error` When `nla_put_*()` call fail.
   void put_attr(nlattr_t);
+
+  /// @brief Non-throwing version of `put_attr()`.
+  /// @returns The libnl error, if `nla_put_*()` fails.
+  [[nodiscard]] expected<> try_put_attr(nlattr_t) noexcept;
+
+  /// @brief Put an attribute of any type space, e.g. inside a nested one.
+  /// @param[in] type Attribute type, e.g. `NL80211_KEY_IDX` or a list index.
+  /// @throw `std::system_error` When `nla_put_*()` call fail.
+  void put_attr(int type, nlattr_val_t const& value);
+
+  /// @brief Non-throwing version of `put_attr()`.
+  /// @returns The libnl error, if `nla_put_*()` fails.
+  [[nodiscard]] expected<> 
+    try_put_attr(int type, nlattr_val_t const& value) noexcept;
+
+  /// @brief Put a NUL-terminated string attribute, without an intermediate copy.
+  /// @throw `std::system_error` when the message is full.
+  void put_string(int type, std::string_view value);
+
+  /// @brief Non-throwing version of `put_string()`.
+  /// @returns The libnl error, if `nla_reserve()` fails.
+  [[nodiscard]] expected<> try_put_string(int type, std::string_view value) noexcept;
+
+  /// @brief Put a binary attribute (MAC address, SSID, frame...) as it is.
+  /// @throw `std::system_error` when the message is full.
+  void put_binary(int type, std::span<std::byte const> value);
+
+  /// @brief Non-throwing version of `put_binary()`.
+  /// @returns The libnl error, if `nla_put()` fails.
+  [[nodiscard]] expected<> 
+    try_put_binary(int type, std::span<std::byte const> value) noexcept;
+
+  /// @brief Open a nested attribute.
+  /// @param[in] type Attribute type, e.g. `NL80211_ATTR_SCAN_FREQUENCIES`.
+  /// @returns The scope of the nest: attributes put until it is closed are
+  ///          nested.
+  /// @throw `std::system_error` when the message is full.
+  /// \code
+  /// auto freqs = msg.nest(NL80211_ATTR_SCAN_FREQUENCIES);
+  /// msg.put_attr(1, 2412u);
+  /// freqs.end();
+  /// \endcode
+  [[nodiscard]] nlnest_t nest(int type);
+
+  /// @brief Non-throwing version of `nest()`.
+  /// @returns The scope, or the error of `nla_nest_start()`.
+  [[nodiscard]] expected<nlnest_t> try_nest(int type) noexcept;
+
+  /// @brief Non-throwing version of `put_attr()` for many attributes.
+  /// @returns The first error. Following attributes are not put.
+  template <is_nlattr_t... Ts> 
+    [[nodiscard]] expected<> try_put_attr(Ts... attr) noexcept;
   
   /// @brief Put more than one `nlattr_t` using a fold expression.
   /// @tparam Ts A `nlattr_t` parameter pack.
@@ -63,9 +189,50 @@ public:
   template <is_nlattr_t... Ts> 
     void put_attr(Ts... attr);
   
+  /// @brief Put an attribute, encoded with its wire type.
+  /// @tparam Attr Attribute name, mapped by `nl80211_attr_traits`.
+  /// @param[in] value Value of the attribute wire type. Strings are not copied.
+  /// @throw `std::system_error` when the message is full.
+  /// @details Unlike `put_attr()`, no variant is built nor visited: the 
+  ///          encoding is chosen at compile time.
+  template <nl80211_attrs Attr, typename T> requires is_nl80211_value<T, Attr>
+    void put(T const& value);
+
+  /// @brief Non-throwing version of `put()`.
+  /// @returns The libnl error, if `nla_put()` fails.
+  template <nl80211_attrs Attr, typename T> requires is_nl80211_value<T, Attr>
+    [[nodiscard]] expected<> try_put(T const& value) noexcept;
+
+  /// @brief Put a flag attribute.
+  /// @throw `std::system_error` when the message is full.
+  template <nl80211_attrs Attr> requires is_nl80211_flag<Attr>
+    void put();
+
+  /// @brief Non-throwing version of `put()` for flags.
+  /// @returns The libnl error, if `nla_put()` fails.
+  template <nl80211_attrs Attr> requires is_nl80211_flag<Attr>
+    [[nodiscard]] expected<> try_put() noexcept;
+
+  /// @brief Returns a handle to patch a top-level attribute in place.
+  /// @tparam Attr Attribute name, with a fixed-size wire type.
+  /// @returns The handle, or `ENOENT` if the attribute was not put, or 
+  ///          `EBADMSG` if its payload has not the wire type size.
+  /// \code
+  /// auto freq = msg.try_slot<NL80211_ATTR_WIPHY_FREQ>();
+  /// freq->set(2437u);
+  /// socket.send_auto(msg); // a new sequence number is assigned
+  /// \endcode
+  template <nl80211_attrs Attr> 
+    requires std::unsigned_integral<nl80211_attr_type_t<Attr>>
+  [[nodiscard]] expected<nlslot_t<nl80211_attr_type_t<Attr>>> try_slot() noexcept;
+
   /// @brief Put a flag inside a netlink message.
-  /// @throw `std::runtime_error` when `nla_put_flag()` call fail.
+  /// @throw `std::system_error` when `nla_put_flag()` call fail.
   void put_flag(nl80211_attrs);
+
+  /// @brief Non-throwing version of `put_flag()`.
+  /// @returns The libnl error, if `nla_put_flag()` fails.
+  [[nodiscard]] expected<> try_put_flag(nl80211_attrs) noexcept;
   
   /// @brief Put more tha one `nl80211_attrs` flags using a fold expression.
   /// @tparam Ts A `nl80211_attrs` parameter pack.
@@ -77,8 +244,17 @@ public:
   /// @param[in] family Netlink family.
   /// @param[in] cmd Netlink command.
   /// @param[in] flags Flags to append.
-  /// @throws `std::runtime_error` when `genlmsg_put()` call fail.
+  /// @throws `std::system_error` when `genlmsg_put()` call fail.
   void put_genl(int family, nl80211_commands cmd, int flags = 0);
+
+  /// @brief Non-throwing version of `put_genl()`.
+  /// @returns An error, if `genlmsg_put()` fails.
+  [[nodiscard]] expected<> 
+    try_put_genl(int family, nl80211_commands cmd, int flags = 0) noexcept;
+
+  /// @brief Version of `try_put_genl()` for the commands of another family.
+  [[nodiscard]] expected<> 
+    try_put_genl(int family, uint8_t cmd, int flags = 0) noexcept;
   
   /// @brief Returns the actual netlink message header pointer.
   /// @returns The message header pointer.
@@ -89,14 +265,71 @@ public:
 
 private:
 
+  /// @brief Find the payload of a top-level genl attribute of size `len`.
+  [[nodiscard]] expected<std::byte*> 
+    try_find_payload(int name, std::size_t len) const noexcept;
+
+  /// @brief Put an attribute payload as it is.
+  [[nodiscard]] expected<> 
+    try_put_raw(int name, void const* data, std::size_t len) noexcept;
+
   /// @brief Custom swap helper. Prevents recursive call of `std::swap()`.
   friend void swap(nlmsg_t& lhs, nlmsg_t& rhs) noexcept {
     std::swap(lhs.msgPtr_, rhs.msgPtr_);
+    std::swap(lhs.pool_, rhs.pool_);
   }
 
 //* Representation / / / / / / / / / / / / / / / / / / / / / / / / / / / / / / / 
 
   struct nl_msg* msgPtr_{}; // underlying pointer
+  nlmsg_pool_t* pool_{};    // optional, recycles `msgPtr_`
+};
+
+
+/**
+ * @brief RAII scope of a nested attribute, opened by `nlmsg_t::nest()`.
+ *
+ * @details
+ * The nest is closed by `end()` or by the dtor, which set its length. 
+ * `cancel()` removes it with everything put inside.
+ */
+class nlnest_t
+{
+public:
+
+  /// @brief Move ctor.
+  nlnest_t(nlnest_t&&) noexcept;
+
+  /// @brief Move assignment operator. Closes the current nest first.
+  /// @returns `*this`.
+  nlnest_t& operator=(nlnest_t&&) noexcept;
+
+  /// @brief Close the nest, if still open.
+  ~nlnest_t();
+
+  /// @brief Close the nest. Following attributes are put after it.
+  void end() noexcept;
+
+  /// @brief Remove the nest and its attributes from the message.
+  void cancel() noexcept;
+
+private:
+
+  friend class nlmsg_t;
+
+  /// @brief Used by `nlmsg_t::try_nest()`.
+  nlnest_t(struct nl_msg* msgPtr, struct nlattr* attrPtr) noexcept;
+
+  /// @brief Custom swap helper. Prevents recursive call of `std::swap()`.
+  friend void swap(nlnest_t& lhs, nlnest_t& rhs) noexcept {
+    std::swap(lhs.msgPtr_, rhs.msgPtr_);
+    std::swap(lhs.attrPtr_, rhs.attrPtr_);
+  }
+
+//* Representation / / / / / / / / / / / / / / / / / / / / / / / / / / / / / / / 
+
+  struct nl_msg* msgPtr_{};   // message of the nest
+  struct nlattr* attrPtr_{};  // nest header, `nullptr` once closed
 };
 
 
@@ -110,6 +343,70 @@ void nlmsg_t::put_attr(Ts... attrs)
 }
 
 
+template <is_nlattr_t... Ts>
+expected<> nlmsg_t::try_put_attr(Ts... attrs) noexcept
+{
+  expected<> result;
+
+  (void)(... && (result = this->try_put_attr(std::move(attrs))).has_value());
+
+  return result;
+}
+
+
+template <nl80211_attrs Attr, typename T> requires is_nl80211_value<T, Attr>
+void nlmsg_t::put(T const& value)
+{
+  unwrap(this->try_put<Attr>(value));
+}
+
+
+template <nl80211_attrs Attr, typename T> requires is_nl80211_value<T, Attr>
+expected<> nlmsg_t::try_put(T const& value) noexcept
+{
+  using wire_t = nl80211_attr_type_t<Attr>;
+
+  if constexpr(std::same_as<wire_t, std::string_view>) {
+    return this->try_put_string(Attr, std::string_view{value});
+  }
+  else if constexpr(std::same_as<wire_t, std::span<std::byte const>>) {
+    return this->try_put_binary(Attr, std::span<std::byte const>{value});
+  }
+  else {
+    return this->try_put_raw(Attr, &value, sizeof(wire_t));
+  }
+}
+
+
+template <nl80211_attrs Attr> requires is_nl80211_flag<Attr>
+void nlmsg_t::put()
+{
+  unwrap(this->try_put<Attr>());
+}
+
+
+template <nl80211_attrs Attr> requires is_nl80211_flag<Attr>
+expected<> nlmsg_t::try_put() noexcept
+{
+  return this->try_put_raw(Attr, nullptr, 0);
+}
+
+
+template <nl80211_attrs Attr> 
+  requires std::unsigned_integral<nl80211_attr_type_t<Attr>>
+expected<nlslot_t<nl80211_attr_type_t<Attr>>> nlmsg_t::try_slot() noexcept
+{
+  using wire_t = nl80211_attr_type_t<Attr>;
+
+  auto payload = this->try_find_payload(Attr, sizeof(wire_t));
+  if(!payload) {
+    return std::unexpected{payload.error()};
+  }
+
+  return nlslot_t<wire_t>{*payload};
+}
+
+
 template <typename... Ts> requires (std::same_as<Ts,nl80211_attrs> && ...)
 void nlmsg_t::put_flag(Ts... flag)
 {
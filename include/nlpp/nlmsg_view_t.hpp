@@ -0,0 +1,281 @@
+#if !defined(NLMSGVIEWT_HPP)
+#define NLMSGVIEWT_HPP
+
+
+/**
+ * @file nlmsg_view_t.hpp
+ * Contains the `nlmsg_view_t` and `nlattr_view_t` class definitions.
+ */
+
+
+#include <linux/genetlink.h>
+#include <linux/netlink.h>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <span>
+#include <string_view>
+#include <type_traits>
+
+
+namespace nlpp {
+
+
+class nlattr_range_t;
+
+
+/**
+ * @brief Non-owning view over a netlink attribute.
+ *
+ * @details
+ * The attribute is read in place from the buffer it was received into, so a
+ * view is only valid until the next receive on the same socket.
+ */
+class nlattr_view_t
+{
+public:
+
+  /// @brief Default ctor. An empty view.
+  constexpr nlattr_view_t() noexcept = default;
+
+  /// @brief Construct a view over an attribute.
+  explicit nlattr_view_t(struct nlattr const* attr) noexcept : attr_{attr} {}
+
+  /// @brief Returns true if the view refers to an attribute.
+  explicit operator bool() const noexcept { return this->attr_ != nullptr; }
+
+  /// @brief Returns the underlying pointer.
+  [[nodiscard]] struct nlattr const* get_pointer() const noexcept
+  {
+    return this->attr_;
+  }
+
+  /// @brief Returns the attribute type, without the nested/byte-order flags.
+  [[nodiscard]] uint16_t type() const noexcept
+  {
+    return this->attr_->nla_type & NLA_TYPE_MASK;
+  }
+
+  /// @brief Returns the attribute payload.
+  [[nodiscard]] std::span<std::byte const> data() const noexcept
+  {
+    return {reinterpret_cast<std::byte const*>(attr_) + NLA_HDRLEN,
+            static_cast<std::size_t>(attr_->nla_len - NLA_HDRLEN)};
+  }
+
+  /// @brief Returns the payload as an integer.
+  /// @returns The value, or `0` if the payload is too short.
+  template <typename T>
+    requires std::is_trivially_copyable_v<T>
+  [[nodiscard]] T get() const noexcept
+  {
+    T value{};
+    auto const payload = this->data();
+
+    if(payload.size() >= sizeof(T)) {
+      std::memcpy(&value, payload.data(), sizeof(T));
+    }
+
+    return value;
+  }
+
+  /// @brief Returns the payload as a string, without the trailing NUL.
+  [[nodiscard]] std::string_view str() const noexcept
+  {
+    auto const payload = this->data();
+    auto const* first = reinterpret_cast<char const*>(payload.data());
+
+    return {first, ::strnlen(first, payload.size())};
+  }
+
+  /// @brief Returns the attributes nested in this attribute.
+  [[nodiscard]] nlattr_range_t nested() const noexcept;
+
+private:
+
+  struct nlattr const* attr_{};
+};
+
+
+/**
+ * @brief Range of the attributes of a stream, walked in place.
+ *
+ * @details Iteration stops at the first malformed attribute, like `nla_ok()`.
+ */
+class nlattr_range_t
+{
+public:
+
+  /// @brief Forward iterator over the attributes.
+  class iterator
+  {
+  public:
+
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = nlattr_view_t;
+    using difference_type = std::ptrdiff_t;
+
+    iterator() noexcept = default;
+
+    iterator(std::byte const* first, std::size_t left) noexcept
+    : pos_{first}, left_{left}
+    {
+      this->validate();
+    }
+
+    nlattr_view_t operator*() const noexcept
+    {
+      return nlattr_view_t{reinterpret_cast<struct nlattr const*>(pos_)};
+    }
+
+    iterator& operator++() noexcept
+    {
+      auto const len = static_cast<std::size_t>(
+        NLA_ALIGN(reinterpret_cast<struct nlattr const*>(pos_)->nla_len));
+
+      len < left_ ? (pos_ += len, left_ -= len) : (pos_ = nullptr, left_ = 0);
+      this->validate();
+
+      return *this;
+    }
+
+    iterator operator++(int) noexcept
+    {
+      auto old = *this;
+      ++*this;
+      return old;
+    }
+
+    bool operator==(iterator const& rhs) const noexcept
+    {
+      return this->pos_ == rhs.pos_;
+    }
+
+  private:
+
+    /// @brief Turn into the end iterator if the attribute is malformed.
+    void validate() noexcept
+    {
+      auto const* attr = reinterpret_cast<struct nlattr const*>(pos_);
+
+      if(!pos_ || left_ < sizeof(struct nlattr)
+        || attr->nla_len < sizeof(struct nlattr) || attr->nla_len > left_)
+      {
+        pos_ = nullptr;
+        left_ = 0;
+      }
+    }
+
+    std::byte const* pos_{};
+    std::size_t left_{};
+  };
+
+  /// @brief Default ctor. An empty range.
+  nlattr_range_t() noexcept = default;
+
+  /// @brief Construct a range over an attribute stream.
+  nlattr_range_t(std::byte const* first, std::size_t len) noexcept
+  : first_{first}, len_{len} {}
+
+  [[nodiscard]] iterator begin() const noexcept { return {first_, len_}; }
+  [[nodiscard]] iterator end() const noexcept { return {}; }
+
+  /// @brief Index the attributes by type, like `nla_parse()` without policy.
+  /// @tparam Max Highest attribute type kept, e.g. `NL80211_ATTR_MAX`.
+  /// @returns A table where missing attributes are empty views.
+  template <std::size_t Max>
+  [[nodiscard]] std::array<nlattr_view_t, Max + 1> table() const noexcept
+  {
+    std::array<nlattr_view_t, Max + 1> tb{};
+
+    for(auto const attr: *this) {
+      if(attr.type() <= Max) {
+        tb[attr.type()] = attr;
+      }
+    }
+
+    return tb;
+  }
+
+private:
+
+  std::byte const* first_{};
+  std::size_t len_{};
+};
+
+
+inline nlattr_range_t nlattr_view_t::nested() const noexcept
+{
+  auto const payload = this->data();
+  return {payload.data(), payload.size()};
+}
+
+
+/**
+ * @brief Non-owning view over a netlink message in a receive buffer.
+ *
+ * @details
+ * Handed to the handlers of `nlsocket_t::recv_raw()`, which parses replies in
+ * place: no `struct nl_msg` is allocated. The view is only valid inside the
+ * handler.
+ */
+class nlmsg_view_t
+{
+public:
+
+  /// @brief Construct a view over a message header.
+  explicit nlmsg_view_t(struct nlmsghdr const* hdr) noexcept : hdr_{hdr} {}
+
+  /// @brief Returns the message header.
+  [[nodiscard]] struct nlmsghdr const* hdr() const noexcept { return hdr_; }
+
+  [[nodiscard]] uint16_t type() const noexcept { return hdr_->nlmsg_type; }
+  [[nodiscard]] uint16_t flags() const noexcept { return hdr_->nlmsg_flags; }
+  [[nodiscard]] uint32_t seq() const noexcept { return hdr_->nlmsg_seq; }
+
+  /// @brief Returns the message payload.
+  [[nodiscard]] std::span<std::byte const> payload() const noexcept
+  {
+    return {reinterpret_cast<std::byte const*>(NLMSG_DATA(hdr_)),
+            static_cast<std::size_t>(hdr_->nlmsg_len - NLMSG_HDRLEN)};
+  }
+
+  /// @brief Returns the genl header, for messages of a generic family.
+  [[nodiscard]] struct genlmsghdr const* genl() const noexcept
+  {
+    return reinterpret_cast<struct genlmsghdr const*>(NLMSG_DATA(hdr_));
+  }
+
+  /// @brief Returns the attributes following a family header.
+  /// @param[in] hdrlen Family header length, e.g. `sizeof(struct ifinfomsg)`.
+  [[nodiscard]] nlattr_range_t attrs(std::size_t hdrlen) const noexcept
+  {
+    auto const payload = this->payload();
+    auto const offset = NLMSG_ALIGN(hdrlen);
+
+    if(payload.size() < offset) {
+      return {};
+    }
+
+    return {payload.data() + offset, payload.size() - offset};
+  }
+
+  /// @brief Returns the attributes of a generic family message.
+  [[nodiscard]] nlattr_range_t genl_attrs() const noexcept
+  {
+    return this->attrs(GENL_HDRLEN);
+  }
+
+private:
+
+  struct nlmsghdr const* hdr_;
+};
+
+
+};  // end namespace nlpp
+
+
+#endif  // NLMSGVIEWT_HPP
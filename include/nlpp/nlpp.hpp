@@ -16,9 +16,13 @@
 #include <linux/nl80211.h>
 #include <linux/netlink.h>
 
+#include <array>
+#include <cstdint>
 #include <string_view>
 #include <string>
 #include <bitset>
+#include <map>
+#include <span>
 #include <vector>
 #include <optional>
 
@@ -320,14 +324,208 @@ struct dev_info_t
 };
 
 
+/// @brief Channel flags.
+/// @note From the `NL80211_FREQUENCY_ATTR_*` flags of `<linux/nl80211.h>`.
+enum class channel_flag_e : uint8_t
+{
+  disabled      = 1<<0, // NL80211_FREQUENCY_ATTR_DISABLED
+  no_ir         = 1<<1, // NL80211_FREQUENCY_ATTR_NO_IR
+  radar         = 1<<2, // NL80211_FREQUENCY_ATTR_RADAR
+  indoor_only   = 1<<3, // NL80211_FREQUENCY_ATTR_INDOOR_ONLY
+  no_ht40_minus = 1<<4, // NL80211_FREQUENCY_ATTR_NO_HT40_MINUS
+  no_ht40_plus  = 1<<5, // NL80211_FREQUENCY_ATTR_NO_HT40_PLUS
+  no_80mhz      = 1<<6, // NL80211_FREQUENCY_ATTR_NO_80MHZ
+  no_160mhz     = 1<<7  // NL80211_FREQUENCY_ATTR_NO_160MHZ
+};
+
+
+/// @brief Set of interface types, indexed by `if_type_e`.
+using if_type_set_t = std::bitset<NUM_NL80211_IFTYPES>;
+
+/// @brief Set of nl80211 commands, indexed by `nl80211_command_e`.
+using command_set_t = std::bitset<NL80211_CMD_MAX + 1>;
+
+
+/**
+ * @brief Set of frequencies, as a bitmap.
+ *
+ * @details
+ * The 2.4 GHz channels 1-14 (2412 + 5k MHz and 2484 MHz) have a slot each;
+ * frequencies from 4900 to 7455 MHz are mapped on a 5 MHz grid, which holds
+ * the 4.9, 5 and 6 GHz channels; 60 GHz channels follow. Frequencies off
+ * these grids are not members of any set.
+ * Lookups are constant time, and the set algebra works a word at a time.
+ */
+class channel_set_t
+{
+public:
+
+  /// @brief Insert a frequency.
+  /// @returns false if the frequency is not on the grid.
+  bool insert(frequency_t const freq) noexcept
+  {
+    auto const bit = slot(freq);
+    if(bit) {
+      bits_.set(*bit);
+    }
+    return bit.has_value();
+  }
+
+  /// @brief Checks if a frequency is in the set.
+  [[nodiscard]] bool contains(frequency_t const freq) const noexcept
+  {
+    auto const bit = slot(freq);
+    return bit && bits_[*bit];
+  }
+
+  /// @brief Checks if a channel is in the set, in any band.
+  [[nodiscard]] bool contains(channel_freq_t const chan) const noexcept;
+
+  /// @brief Returns the number of frequencies.
+  [[nodiscard]] std::size_t size() const noexcept { return bits_.count(); }
+
+  /// @brief Returns true if the set is empty.
+  [[nodiscard]] bool empty() const noexcept { return bits_.none(); }
+
+  /// @brief Returns the frequencies of the set, in ascending order.
+  [[nodiscard]] std::vector<frequency_t> freqs() const;
+
+  /// @brief Intersection.
+  [[nodiscard]] friend channel_set_t 
+  operator&(channel_set_t lhs, channel_set_t const& rhs) noexcept 
+  {
+    lhs.bits_ &= rhs.bits_;
+    return lhs;
+  }
+
+  /// @brief Union.
+  [[nodiscard]] friend channel_set_t 
+  operator|(channel_set_t lhs, channel_set_t const& rhs) noexcept 
+  {
+    lhs.bits_ |= rhs.bits_;
+    return lhs;
+  }
+
+  [[nodiscard]] friend bool 
+  operator==(channel_set_t const&, channel_set_t const&) noexcept = default;
+
+private:
+
+  static constexpr unsigned ism_first = 2412;   // MHz, 2.4 GHz channel 1
+  static constexpr unsigned ism_step = 5;       // MHz
+  static constexpr std::size_t ism_size = 13;   // channels 1-13
+  static constexpr unsigned ism_ch14 = 2484;    // MHz, off the 2.4 GHz grid
+  static constexpr std::size_t grid_offset = ism_size + 1;
+  static constexpr unsigned grid_first = 4900;  // MHz
+  static constexpr unsigned grid_step = 5;      // MHz
+  static constexpr std::size_t grid_size = 512;
+  static constexpr std::size_t dmg_offset = grid_offset + grid_size;
+  static constexpr unsigned dmg_first = 58320;  // MHz, 60 GHz channel 1
+  static constexpr unsigned dmg_step = 2160;    // MHz
+  static constexpr std::size_t dmg_size = 8;
+
+  /// @brief Returns the bit of a frequency, if on a grid.
+  [[nodiscard]] static std::optional<std::size_t> 
+    slot(frequency_t const freq) noexcept
+  {
+    auto const f = freq.get();
+
+    if(f == ism_ch14) {
+      return ism_size;
+    }
+    if(auto const bit = on_grid(f, ism_first, ism_step, ism_size)) {
+      return *bit;
+    }
+    if(auto const bit = on_grid(f, grid_first, grid_step, grid_size)) {
+      return grid_offset + *bit;
+    }
+    if(auto const bit = on_grid(f, dmg_first, dmg_step, dmg_size)) {
+      return dmg_offset + *bit;
+    }
+
+    return std::nullopt;
+  }
+
+  /// @brief Returns the position of `f` on a grid, if it is one of its points.
+  [[nodiscard]] static constexpr std::optional<std::size_t> 
+    on_grid(unsigned f, unsigned first, unsigned step, std::size_t size) noexcept
+  {
+    if(f < first || (f - first) % step != 0 || (f - first) / step >= size) {
+      return std::nullopt;
+    }
+
+    return (f - first) / step;
+  }
+
+  std::bitset<dmg_offset + dmg_size> bits_;
+};
+
+
+/// @brief Helper struct containing the capabilities of a band.
+/// @details Its channels are `[first, first + count)` of `wiphy_channels_t`.
+struct band_capability_t
+{
+  nl80211_band band;                ///< Type of the `NL80211_ATTR_WIPHY_BANDS` nest
+  uint32_t first{};                 ///< First channel of the band
+  uint32_t count{};                 ///< Number of channels of the band
+  std::vector<uint32_t> bitrates;   ///< From `NL80211_BITRATE_ATTR_RATE`, in 100 kbps
+  std::optional<uint16_t> ht_capa;  ///< From `NL80211_BAND_ATTR_HT_CAPA`
+  std::optional<uint32_t> vht_capa; ///< From `NL80211_BAND_ATTR_VHT_CAPA`
+  std::vector<uint8_t> he_phy_capa; ///< From `NL80211_BAND_IFTYPE_ATTR_HE_CAP_PHY`
+};
+
+
+/// @brief Helper struct containing the channels of a device.
+/// @details
+/// Structure of arrays: the columns are indexed by channel, so the scans of
+/// a hop planner walk contiguous memory. Channels are grouped by band.
+struct wiphy_channels_t
+{
+  std::vector<frequency_t> freqs;     ///< From `NL80211_FREQUENCY_ATTR_FREQ`
+  std::vector<uint8_t> flags;         ///< `channel_flag_e` bits
+  std::vector<uint32_t> max_tx_power; ///< From `NL80211_FREQUENCY_ATTR_MAX_TX_POWER`, in mBm
+  std::vector<band_capability_t> bands; ///< Bands, in the order of the kernel
+  channel_set_t supported;            ///< Bitmap of `freqs`
+  channel_set_t usable;               ///< Bitmap of `freqs` not disabled
+
+  /// @brief Returns the number of channels.
+  [[nodiscard]] std::size_t size() const noexcept { return freqs.size(); }
+
+  /// @brief Returns the channel of a frequency.
+  /// @param[in] freq Frequency to look for.
+  /// @returns Its index in the columns, or `std::nullopt` if not supported.
+  [[nodiscard]] std::optional<std::size_t> find(frequency_t const freq) const noexcept;
+
+  /// @brief Checks a flag of a channel.
+  /// @param[in] chan Index of the channel.
+  /// @param[in] flag Flag to check.
+  /// @returns true if the flag is set.
+  [[nodiscard]] bool has(std::size_t const chan, channel_flag_e const flag) const noexcept
+  {
+    return flags[chan] & static_cast<uint8_t>(flag);
+  }
+
+  /// @brief Returns the frequencies of a band.
+  /// @param[in] band A band of `bands`.
+  [[nodiscard]] std::span<frequency_t const> 
+    freqs_of(band_capability_t const& band) const noexcept
+  {
+    return std::span{freqs}.subspan(band.first, band.count);
+  }
+};
+
+
+struct capability_set_t;
+
+
 /// @brief Helper struct containing the device capabilities.
 struct dev_capability_t
 {
   wiphy_index_t wiphy_index;            ///< From `NL80211_ATTR_WIPHY`
   std::string wiphy_name;               ///< From `NL80211_ATTR_WIPHY_NAME`
-  std::vector<if_type_e> iftypes;       ///< From `NL80211_ATTR_SUPPORTED_IFTYPES`
-  std::vector<frequency_t> freqs;       ///< From `NL80211_FREQUENCY_ATTR_FREQ`
-  std::vector<nl80211_command_e> cmds;  ///< From `NL80211_ATTR_SUPPORTED_COMMANDS`
+  if_type_set_t iftypes;                ///< From `NL80211_ATTR_SUPPORTED_IFTYPES`
+  wiphy_channels_t channels;            ///< From `NL80211_ATTR_WIPHY_BANDS`
+  command_set_t cmds;                   ///< From `NL80211_ATTR_SUPPORTED_COMMANDS`
 
   /// @brief Checks if a interface type is supported by this device.
   /// @param[in] mode Interface type mode to check.
@@ -343,6 +541,26 @@ struct dev_capability_t
   /// @param[in] chan Frequency channel to check.
   /// @returns true if `chan` is supported, otherwise false.
   [[nodiscard]] bool is_supported(channel_freq_t const chan) const;
+
+  /// @brief Checks if a frequency can be tuned to, i.e. it is supported and
+  ///        not disabled.
+  /// @param[in] freq Frequency to check.
+  /// @returns true if `freq` is usable, otherwise false.
+  [[nodiscard]] bool is_usable(frequency_t const freq) const;
+
+  /// @brief Checks if a frequency channel can be tuned to.
+  /// @param[in] chan Frequency channel to check.
+  /// @returns true if `chan` is usable, otherwise false.
+  [[nodiscard]] bool is_usable(channel_freq_t const chan) const;
+
+  /// @brief Returns the frequencies which can be tuned to, e.g. a hop list.
+  /// @param[in] excluded Flags of the channels to leave out as well, e.g. 
+  ///            `channel_flag_e::radar`.
+  [[nodiscard]] std::vector<frequency_t> 
+    usable_freqs(std::initializer_list<channel_flag_e> excluded = {}) const;
+
+  /// @brief Returns the capabilities as sets, see `capability_set_t`.
+  [[nodiscard]] capability_set_t sets() const noexcept;
   
   /// @brief Check is a nl80211 command is supported by this device.
   /// @param[in] cmd A nl80211 command to check.
@@ -362,6 +580,45 @@ struct dev_capability_t
 };
 
 
+/**
+ * @brief Capabilities reduced to sets, for the set algebra across phys.
+ *
+ * \code
+ * auto const common = nlpp::intersect(genl.get_list_phys());
+ * if(common.channels.contains(nlpp::channel_freq_t{36})) { ... }
+ * \endcode
+ */
+struct capability_set_t
+{
+  if_type_set_t iftypes;  ///< Supported interface types
+  command_set_t cmds;     ///< Supported commands
+  channel_set_t channels; ///< Usable frequencies
+
+  /// @brief Intersection.
+  [[nodiscard]] friend capability_set_t 
+  operator&(capability_set_t lhs, capability_set_t const& rhs) noexcept 
+  {
+    lhs.iftypes &= rhs.iftypes;
+    lhs.cmds &= rhs.cmds;
+    lhs.channels = lhs.channels & rhs.channels;
+    return lhs;
+  }
+
+  /// @brief Union.
+  [[nodiscard]] friend capability_set_t 
+  operator|(capability_set_t lhs, capability_set_t const& rhs) noexcept 
+  {
+    lhs.iftypes |= rhs.iftypes;
+    lhs.cmds |= rhs.cmds;
+    lhs.channels = lhs.channels | rhs.channels;
+    return lhs;
+  }
+
+  [[nodiscard]] friend bool 
+  operator==(capability_set_t const&, capability_set_t const&) noexcept = default;
+};
+
+
 // Helper functions / / / / / / / / / / / / / / / / / / / / / / / / / / / / / / 
 
 /// @brief Translation from operational status code to std::string.
@@ -400,6 +657,19 @@ struct dev_capability_t
 [[nodiscard]] std::string to_string(dev_capability_t const& capability);
 
 
+/// @brief Returns the capabilities shared by all phys.
+/// @param[in] phys Phys, e.g. from `NetlinkGeneric::get_list_phys()`.
+/// @returns The intersection of their sets, empty if `phys` is empty.
+[[nodiscard]] capability_set_t 
+  intersect(std::map<uint32_t,dev_capability_t> const& phys) noexcept;
+
+/// @brief Returns the capabilities of any phy.
+/// @param[in] phys Phys, e.g. from `NetlinkGeneric::get_list_phys()`.
+/// @returns The union of their sets.
+[[nodiscard]] capability_set_t 
+  unite(std::map<uint32_t,dev_capability_t> const& phys) noexcept;
+
+
 /// @brief Returns the wiphy index from his name.
 /// @param[in] phy_name Physical device name.
 /// @returns The wiphy index associated to a name.
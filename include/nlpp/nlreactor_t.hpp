@@ -0,0 +1,219 @@
+#if !defined(NLREACTOR_HPP)
+#define NLREACTOR_HPP
+
+
+/**
+ * @file nlreactor_t.hpp
+ * Contains the `nlreactor_t` class definition.
+ */
+
+
+#include "nlsocket_t.hpp"
+#include "task.hpp"
+
+#include <chrono>
+#include <coroutine>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+
+namespace nlpp {
+
+
+/**
+ * @brief Small `epoll` reactor that drives many `nlsocket_t` from one thread.
+ *
+ * @details
+ * Registered sockets are switched to non-blocking mode. Requests are issued
+ * with `nlsocket_t::send_async()` and their completions are invoked by
+ * `run_once()` or `run()` as soon as the kernel replies, so one thread can
+ * serve the netlink traffic of many adapters concurrently.
+ *
+ * \code
+ * nlpp::nlreactor_t reactor;
+ * reactor.add(socket);
+ * socket.send_async(msg, handler, &result, [](int error) { ... });
+ * reactor.run();
+ * \endcode
+ *
+ * Coroutines awaiting `async_send()` are resumed by the reactor after the 
+ * socket has been dispatched, never from inside a libnl callback.
+ *
+ * A reply may be lost, e.g. when a receive queue overruns: `run(timeout)` 
+ * bounds the wait and fails the requests still pending with `-ETIMEDOUT`.
+ */
+class nlreactor_t
+{
+public:
+
+  class request_awaiter;
+
+  /// @brief Default ctor. Create the `epoll` instance.
+  /// @throws `std::system_error` when `epoll_create1()` fails.
+  nlreactor_t();
+
+  /// @brief Move ctor.
+  nlreactor_t(nlreactor_t&&) noexcept;
+
+  /// @brief Move assignment operator.
+  /// @returns `*this`.
+  nlreactor_t& operator=(nlreactor_t&&) noexcept;
+
+  /// @brief Close the `epoll` instance.
+  ~nlreactor_t();
+
+  /// @brief Returns the `epoll` file descriptor.
+  /// @returns A descriptor that becomes readable when a socket has replies.
+  /// @note Useful to nest this reactor inside another event loop.
+  [[nodiscard]] int fd() const noexcept { return this->epollFd_; }
+
+  /// @brief Returns the number of asynchronous requests not yet completed.
+  [[nodiscard]] std::size_t pending() const noexcept;
+
+  /// @brief Register a socket and switch it to non-blocking mode.
+  /// @param[in] socket A connected socket. It must not move while registered.
+  /// @throws `std::system_error` when `epoll_ctl()` fails.
+  void add(nlsocket_t& socket);
+
+  /// @brief Unregister a socket.
+  /// @param[in] socket A socket previously registered with `add()`.
+  void remove(nlsocket_t& socket) noexcept;
+
+  /// @brief Wait for replies and dispatch them to their completions.
+  /// @param[in] timeout_ms Maximum time to wait, `-1` waits forever.
+  /// @returns The number of sockets that were dispatched.
+  /// @throws `std::system_error` when `epoll_wait()` fails.
+  std::size_t run_once(int timeout_ms = -1);
+
+  /// @brief Dispatch replies until no asynchronous request is pending.
+  /// @warning Waits forever for a lost reply: see `run(timeout)`.
+  void run();
+
+  /// @brief Dispatch replies until no asynchronous request is pending, or
+  ///        until the timeout expires.
+  /// @param[in] timeout Maximum time to run.
+  /// @returns false if the timeout expired: the requests still pending are
+  ///          then completed with `-ETIMEDOUT` and their awaiters resumed.
+  /// @throws `std::system_error` when `epoll_wait()` fails.
+  bool run(std::chrono::milliseconds timeout);
+
+  /// @brief Deadline version of `run(timeout)`.
+  bool run_until(std::chrono::steady_clock::time_point deadline);
+
+  /// @brief Resume a coroutine on the next `run_once()`.
+  /// @param[in] handle Coroutine to resume.
+  /// @throws `std::bad_alloc` when the coroutine cannot be queued.
+  void schedule(std::coroutine_handle<> handle);
+
+  /// @brief Resume the coroutine of a completed request on the next 
+  ///        `run_once()`.
+  /// @details The awaiter itself is queued: invoked by a completion, this
+  ///          must not allocate.
+  void schedule(request_awaiter& awaiter) noexcept;
+
+  /// @brief Send a request and suspend the coroutine until it completes.
+  /// @param[in] socket A socket registered with `add()`.
+  /// @param[in] msg Netlink message to send.
+  /// @param[in] fun Optional valid-message handler.
+  /// @param[in] arg Optional valid-message handler parameter.
+  /// @returns An awaitable whose result is `0` or the negated errno.
+  [[nodiscard]] request_awaiter async_send(nlsocket_t& socket, nlmsg_t msg, 
+    nl_recvmsg_msg_cb_t fun = {}, void* arg = {});
+
+  /// @brief Start a task and run the reactor until it completes.
+  /// @param[in] t Task to run.
+  /// @returns The task result.
+  /// @throws Any exception thrown by the task.
+  template <typename T> T sync_wait(task<T> t);
+
+private:
+
+  /// @brief Custom swap helper. Prevents recursive call of `std::swap()`.
+  friend void swap(nlreactor_t& lhs, nlreactor_t& rhs) noexcept
+  {
+    std::swap(lhs.epollFd_, rhs.epollFd_);
+    std::swap(lhs.sockets_, rhs.sockets_);
+    std::swap(lhs.ready_, rhs.ready_);
+    std::swap(lhs.readyHead_, rhs.readyHead_);
+    std::swap(lhs.readyTail_, rhs.readyTail_);
+  }
+
+  /// @brief Returns true if a coroutine is scheduled.
+  [[nodiscard]] bool has_ready() const noexcept;
+
+  /// @brief Resume every scheduled coroutine.
+  /// @returns The number of resumed coroutines.
+  std::size_t resume_ready();
+
+//* Representation / / / / / / / / / / / / / / / / / / / / / / / / / / / / / / /
+
+  int epollFd_{-1};                   // `epoll` instance
+  std::vector<nlsocket_t*> sockets_;  // registered sockets
+  std::vector<std::coroutine_handle<>> ready_; // coroutines to resume
+  request_awaiter* readyHead_{};      // completed requests to resume, in order
+  request_awaiter* readyTail_{};
+};
+
+
+/**
+ * @brief Awaitable returned by `nlreactor_t::async_send()`.
+ */
+class nlreactor_t::request_awaiter
+{
+public:
+
+  /// @brief Construct the awaitable. The request is sent on suspension.
+  request_awaiter(nlreactor_t& reactor, nlsocket_t& socket, nlmsg_t msg,
+                  nl_recvmsg_msg_cb_t fun, void* arg) noexcept
+  : reactor_{reactor}, socket_{socket}, msg_{std::move(msg)}, fun_{fun}, 
+    arg_{arg} {}
+
+  bool await_ready() const noexcept { return false; }
+
+  void await_suspend(std::coroutine_handle<> handle)
+  {
+    handle_ = handle;
+    socket_.send_async(msg_, fun_, arg_, [this](int error) {
+      error_ = error;
+      reactor_.schedule(*this);
+    });
+  }
+
+  int await_resume() const noexcept { return error_; }
+
+private:
+
+  friend class nlreactor_t;
+
+  nlreactor_t& reactor_;
+  nlsocket_t& socket_;
+  nlmsg_t msg_;
+  nl_recvmsg_msg_cb_t fun_;
+  void* arg_;
+  int error_{1};
+  std::coroutine_handle<> handle_;  // suspended coroutine
+  request_awaiter* next_{};         // in the ready list of the reactor
+};
+
+
+//* function template definitions / / / / / / / / / / / / / / / / / / / / / / /
+
+
+template <typename T> 
+T nlreactor_t::sync_wait(task<T> t)
+{
+  t.start();
+
+  while(!t.done()) {
+    this->run_once();
+  }
+
+  return t.result();
+}
+
+
+};  // end namespace nlpp
+
+
+#endif // NLREACTOR_HPP
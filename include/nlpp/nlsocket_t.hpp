@@ -8,26 +8,103 @@
  */
 
 
+#include "error.hpp"
 #include "nlpp.hpp"
 #include "nlcb_t.hpp"
 #include "nlmsg_t.hpp"
+#include "nlmsg_view_t.hpp"
 
 #include <netlink/socket.h>
-
+#include <sys/uio.h>
+
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <span>
 #include <utility>
+#include <vector>
 
 
 namespace nlpp {
 
 
+/// @brief Completion callback of an asynchronous request.
+/// @details Receives `0` on success, otherwise the negated errno.
+using nlcompletion_t = std::function<void(int error)>;
+
+
+/// @brief A single request of a pipelined batch or an asynchronous request.
+/// @see `nlsocket_t::transact()`
+/// @see `nlsocket_t::send_async()`
+struct nlrequest_t
+{
+  nlmsg_t const* msg{};       ///< Request message (must outlive the batch)
+  nl_recvmsg_msg_cb_t fun{};  ///< Optional valid-message handler
+  void* arg{};                ///< Optional valid-message handler parameter
+  uint32_t seq{};             ///< Sequence number, assigned on send
+  int error{1};               ///< `>0` pending, `0` done, `<0` negated errno
+  nlcompletion_t done{};      ///< Optional completion (asynchronous only)
+  int cmd{};                  ///< genl command or message type, set on send
+};
+
+
+/// @brief Outcome of a request sent with `nlsocket_t::send_nowait()`.
+struct nlack_t
+{
+  uint32_t seq{};   ///< Sequence number of the request
+  int cmd{};        ///< genl command or message type of the request
+  int error{};      ///< `0` on ACK, otherwise the negated errno
+};
+
+
+/// @brief Handler of the outcomes of the requests sent without waiting.
+using nlack_handler_t = std::function<void(nlack_t const&)>;
+
+
+/// @brief Valid-message handler of `nlsocket_t::recv_raw()`.
+/// @details Returns `NL_OK`/`NL_SKIP` to go on, `NL_STOP` to skip the rest of
+///          the datagram. Unlike libnl, a `NLMSG_DONE` or error message of 
+///          that datagram still ends the reply.
+using nlview_cb_t = int (*)(nlmsg_view_t msg, void* arg);
+
+
 /**
  * @brief Simple C++ wrapper around a `struct nl_sock` with RAII. 
+ * 
+ * @details
+ * The socket owns a persistent callback set, configured once at construction
+ * with the default error, finish and ack handlers. Each request only swaps in
+ * its own valid-message handler, so no `struct nl_cb` is allocated per request.
+ *
+ * Blocking receives honour a deadline: the socket timeout set with 
+ * `set_timeout()`, or the one passed to a single call. When it expires the
+ * call fails with `ETIMEDOUT` and the late replies are discarded.
+ *
+ * Large dumps can be tuned with `set_rcvbuf()`, `set_msg_buf_size()` and
+ * `set_peek()`. In auto-tune mode a truncated message or a receive queue 
+ * overrun grows the buffers and the call fails with `EMSGSIZE` or `ENOBUFS`,
+ * so that the request can be issued again. Otherwise a truncated message
+ * fails the call with `EMSGSIZE` as well.
  */
 class nlsocket_t
 {
 public:
 
-  /// @brief Default ctor. Allocate a nl socket.
+  /// @brief Timeout value that waits forever.
+  static constexpr std::chrono::milliseconds no_timeout{-1};
+
+  /// @brief Largest datagram the kernel builds for a dump.
+  /// @details A message buffer of this size receives any dump datagram in a 
+  ///          single `recvmsg()`, without peeking.
+  static constexpr std::size_t dump_msg_buf_size = 32768;
+
+  /// @brief Largest receive buffer requested by the auto-tune mode.
+  static constexpr int max_autotune_rcvbuf = 8 << 20;
+
+  /// @brief Default ctor. Allocate a nl socket and its callback set.
   /// @throws `std::system_error` when not enough memory available.
   nlsocket_t();
 
@@ -53,30 +130,326 @@ public:
   /// @returns Tue if the socket is connected.
   [[nodiscard]] bool connected() const noexcept { return this->connected_; }
 
+  /// @brief Returns the socket file descriptor.
+  /// @returns The file descriptor, or `-1` if the socket is not connected.
+  [[nodiscard]] int fd() const noexcept;
+
+  /// @brief Returns the number of asynchronous requests not yet completed.
+  [[nodiscard]] std::size_t pending() const noexcept { return inflight_.size(); }
+
+  /// @brief Returns the default timeout of the blocking receives.
+  [[nodiscard]] std::chrono::milliseconds timeout() const noexcept 
+  { 
+    return this->timeout_; 
+  }
+
+  /// @brief Returns the socket receive buffer size.
+  /// @returns The size reported by `SO_RCVBUF`, or `-1` on error.
+  [[nodiscard]] int rcvbuf() const noexcept;
+
+  /// @brief Returns the libnl message buffer size, `0` if libnl default.
+  [[nodiscard]] std::size_t msg_buf_size() const noexcept 
+  { 
+    return this->msg_buf_size_; 
+  }
+
+  /// @brief Returns true if the buffers grow on truncation or overrun.
+  [[nodiscard]] bool autotune() const noexcept { return this->autotune_; }
+
 
 //* libnl API / / / / / / / / / / / / / / / / / / / / / / / / / / / / / / / / / 
 
 
   /// @brief Connect to a netlink kernel subsystem using the socket.
   /// @param[in] protocol Netlink protocol to use.
-  /// @throws `std::runtime_error` When connection fails.
+  /// @throws `std::system_error` When connection fails.
   void connect(netlink_protocol_e protocol);
 
+  /// @brief Non-throwing version of `connect()`.
+  [[nodiscard]] expected<> try_connect(netlink_protocol_e protocol) noexcept;
+
   /// @brief Close connection.
   void close();
 
-  /// @brief Set callback.
+  /// @brief Switch the socket to non-blocking mode.
+  /// @throws `std::system_error` When `nl_socket_set_nonblocking()` fails.
+  /// @details Blocking calls keep working: they poll the socket internally.
+  void set_nonblocking();
+
+  /// @brief Non-throwing version of `set_nonblocking()`.
+  [[nodiscard]] expected<> try_set_nonblocking() noexcept;
+
+  /// @brief Set the default timeout of the blocking receives.
+  /// @param[in] timeout Maximum time to wait for a reply, or `no_timeout`.
+  /// @throws `std::system_error` When `setsockopt(SO_RCVTIMEO)` fails.
+  /// @details The timeout is also applied as `SO_RCVTIMEO`, so it bounds the
+  ///          libnl helpers that receive on this socket by themselves.
+  void set_timeout(std::chrono::milliseconds timeout);
+
+  /// @brief Non-throwing version of `set_timeout()`.
+  [[nodiscard]] expected<> 
+    try_set_timeout(std::chrono::milliseconds timeout) noexcept;
+
+  /// @brief Set the socket receive buffer size.
+  /// @param[in] bytes Requested size.
+  /// @param[in] force Use `SO_RCVBUFFORCE` to exceed `rmem_max`. Without 
+  ///            `CAP_NET_ADMIN` it falls back to `SO_RCVBUF`.
+  /// @throws `std::system_error` When `setsockopt()` fails.
+  void set_rcvbuf(int bytes, bool force = false);
+
+  /// @brief Non-throwing version of `set_rcvbuf()`.
+  [[nodiscard]] expected<> try_set_rcvbuf(int bytes, bool force = false) noexcept;
+
+  /// @brief Set the size of the buffer libnl receives messages into.
+  /// @param[in] bytes Buffer size, `dump_msg_buf_size` fits any dump datagram.
+  /// @throws `std::system_error` When `nl_socket_set_msg_buf_size()` fails.
+  /// @note An explicit size disables the default peeking, unless it is 
+  ///       re-enabled with `set_peek()`.
+  void set_msg_buf_size(std::size_t bytes);
+
+  /// @brief Non-throwing version of `set_msg_buf_size()`.
+  [[nodiscard]] expected<> try_set_msg_buf_size(std::size_t bytes) noexcept;
+
+  /// @brief Enable or disable `MSG_PEEK` on receive.
+  /// @details Peeking never truncates a message, at the cost of two 
+  ///          `recvmsg()` per datagram.
+  void set_peek(bool enable) noexcept;
+
+  /// @brief Enable or disable `NETLINK_NO_ENOBUFS`.
+  /// @throws `std::system_error` When `setsockopt()` fails.
+  /// @note The kernel then drops the messages that overrun the receive queue
+  ///       silently, instead of reporting `ENOBUFS`.
+  void set_no_enobufs(bool enable);
+
+  /// @brief Non-throwing version of `set_no_enobufs()`.
+  [[nodiscard]] expected<> try_set_no_enobufs(bool enable) noexcept;
+
+  /// @brief Enable or disable the auto-tune mode.
+  /// @details On a truncated message the message buffer doubles, on `ENOBUFS`
+  ///          the receive buffer doubles (forced, up to `max_autotune_rcvbuf`).
+  ///          The receive still fails, since the kernel dropped data.
+  void set_autotune(bool enable) noexcept { this->autotune_ = enable; }
+
+  /// @brief Enable or disable `NETLINK_CAP_ACK`.
+  /// @throws `std::system_error` When `setsockopt()` fails.
+  /// @details Error ACKs then carry only the header of the failed request 
+  ///          instead of echoing its whole payload.
+  void set_cap_ack(bool enable);
+
+  /// @brief Non-throwing version of `set_cap_ack()`.
+  [[nodiscard]] expected<> try_set_cap_ack(bool enable) noexcept;
+
+  /// @brief Enable or disable `NETLINK_GET_STRICT_CHK`.
+  /// @throws `std::system_error` When `setsockopt()` fails, `ENOPROTOOPT` 
+  ///         before Linux 4.20.
+  /// @details The kernel then validates the headers of the dump requests and
+  ///          honours their filter attributes, instead of ignoring them.
+  void set_strict_check(bool enable);
+
+  /// @brief Non-throwing version of `set_strict_check()`.
+  [[nodiscard]] expected<> try_set_strict_check(bool enable) noexcept;
+
+  /// @brief Join a multicast group, to receive its notifications.
+  /// @param[in] group Group id, e.g. from `genl_family_t::group()`.
+  /// @throws `std::system_error` When `nl_socket_add_membership()` fails.
+  /// @note Notifications carry no sequence number: receive them on a socket
+  ///       which does not send requests.
+  void add_membership(uint32_t group);
+
+  /// @brief Non-throwing version of `add_membership()`.
+  [[nodiscard]] expected<> try_add_membership(uint32_t group) noexcept;
+
+  /// @brief Set the handler of the outcomes of `send_nowait()` requests.
+  /// @param[in] handler Invoked for every ACK and error. If empty, errors are
+  ///            queued for `take_errors()` and ACKs are dropped.
+  /// @note The handler must not throw.
+  void set_ack_handler(nlack_handler_t handler) noexcept 
+  { 
+    this->ack_handler_ = std::move(handler); 
+  }
+
+  /// @brief Returns and clears the queued errors of `send_nowait()` requests.
+  [[nodiscard]] std::vector<nlack_t> take_errors() noexcept
+  {
+    return std::exchange(this->errors_, {});
+  }
+
+  /// @brief Replace the socket callback set.
+  /// @details The default error, finish and ack handlers are installed on it.
   void set_cb(nlcb_t);
 
   /// @brief Finalize and transmit a Netlink message.
   /// @param[in] msg Netlink message to send.
-  /// @throws `std::runtime_error` When `nl_send_auto()` fails.
+  /// @throws `std::system_error` When `nl_send_auto()` fails.
+  /// @details Every send assigns a new sequence number, so a prebuilt 
+  ///          message can be sent again and again.
   void send_auto(nlmsg_t const& msg);
 
+  /// @brief Non-throwing version of `send_auto()`.
+  [[nodiscard]] expected<> try_send_auto(nlmsg_t const& msg) noexcept;
+
+  /// @brief Receive a set of messages using the persistent callback set.
+  /// @param[in] fun Optional valid-message handler for this request.
+  /// @param[in] arg Optional valid-message handler parameter.
+  /// @param[in] timeout Optional timeout overriding `timeout()`.
+  /// @throws `std::system_error` When the kernel replies with an error, or
+  ///         with `ETIMEDOUT` when the deadline expires.
+  void recvmsgs(nl_recvmsg_msg_cb_t fun = {}, void* arg = {},
+                std::optional<std::chrono::milliseconds> timeout = {});
+
+  /// @brief Non-throwing version of `recvmsgs()`.
+  /// @returns The kernel errno and the command of the last sent message.
+  [[nodiscard]] expected<> 
+    try_recvmsgs(nl_recvmsg_msg_cb_t fun = {}, void* arg = {},
+                 std::optional<std::chrono::milliseconds> timeout = {}) noexcept;
+
+  /// @brief Receive a reply in place, bypassing libnl.
+  /// @param[in] fun Optional valid-message handler for this request.
+  /// @param[in] arg Optional valid-message handler parameter.
+  /// @param[in] timeout Optional timeout overriding `timeout()`.
+  /// @throws `std::system_error` When the kernel replies with an error, or
+  ///         with `ETIMEDOUT` when the deadline expires.
+  /// @details Datagrams are read with `recvmsg()` into a page-aligned buffer
+  ///          owned by the socket, and the `nlmsghdr` chain is walked in 
+  ///          place: a dump costs no heap allocation per message.
+  void recv_raw(nlview_cb_t fun = {}, void* arg = {},
+                std::optional<std::chrono::milliseconds> timeout = {});
+
+  /// @brief Non-throwing version of `recv_raw()`.
+  [[nodiscard]] expected<> 
+    try_recv_raw(nlview_cb_t fun = {}, void* arg = {},
+                 std::optional<std::chrono::milliseconds> timeout = {}) noexcept;
+
+  /// @brief Receive a single datagram of a reply in place.
+  /// @param[in] fun Optional valid-message handler for this request.
+  /// @param[in] arg Optional valid-message handler parameter.
+  /// @param[in] timeout Optional timeout overriding `timeout()`.
+  /// @returns true once the reply is complete.
+  /// @throws `std::system_error` When the kernel replies with an error, or
+  ///         with `ETIMEDOUT` when the deadline expires.
+  /// @details The building block of the streaming dumps: the kernel fills
+  ///          the next datagram of a dump only after this one is read.
+  /// @warning The kernel refuses a new dump on the socket with `EBUSY` until
+  ///          the running one ends: read a reply abandoned halfway to its 
+  ///          end, e.g. with no handler.
+  bool recv_raw_next(nlview_cb_t fun = {}, void* arg = {},
+                     std::optional<std::chrono::milliseconds> timeout = {});
+
+  /// @brief Non-throwing version of `recv_raw_next()`.
+  [[nodiscard]] expected<bool> 
+    try_recv_raw_next(nlview_cb_t fun = {}, void* arg = {},
+                      std::optional<std::chrono::milliseconds> timeout = {}) noexcept;
+
   /// @brief Receive a set of messages.
-  /// @param[in] cb Set of callbacks to control the behaviour.
-  /// @throws `std::runtime_error` When `nl_recvmsgs()` fails.
-  void recvmsgs(nlcb_t& cb);
+  /// @param[in] cb Set of callbacks to control the behaviour. Its error, 
+  ///            finish and ack handlers are replaced.
+  /// @param[in] timeout Optional timeout overriding `timeout()`.
+  /// @throws `std::system_error` When the kernel replies with an error, or
+  ///         with `ETIMEDOUT` when the deadline expires.
+  void recvmsgs(nlcb_t& cb, std::optional<std::chrono::milliseconds> timeout = {});
+
+  /// @brief Non-throwing version of `recvmsgs(nlcb_t&)`.
+  [[nodiscard]] expected<> try_recvmsgs(nlcb_t& cb, 
+    std::optional<std::chrono::milliseconds> timeout = {}) noexcept;
+
+  /// @brief Finalize a batch of messages and transmit them in one `sendmsg()`.
+  /// @param[inout] batch Requests to send. Each `seq` member is assigned.
+  /// @throws `std::system_error` When `sendmsg()` fails.
+  void send_batch(std::span<nlrequest_t> batch);
+
+  /// @brief Non-throwing version of `send_batch()`.
+  [[nodiscard]] expected<> try_send_batch(std::span<nlrequest_t> batch) noexcept;
+
+  /// @brief Receive replies for a batch, routing them by sequence number.
+  /// @param[inout] batch Requests previously sent with `send_batch()`.
+  /// @param[in] timeout Optional timeout overriding `timeout()`.
+  /// @throws `std::system_error` When `nl_recvmsgs()` fails or the deadline
+  ///         expires. Requests still pending then fail with `-ETIMEDOUT`.
+  /// @note Kernel errors do not throw: they are stored in each `error` member.
+  void recv_batch(std::span<nlrequest_t> batch,
+                  std::optional<std::chrono::milliseconds> timeout = {});
+
+  /// @brief Non-throwing version of `recv_batch()`.
+  [[nodiscard]] expected<> try_recv_batch(std::span<nlrequest_t> batch,
+    std::optional<std::chrono::milliseconds> timeout = {}) noexcept;
+
+  /// @brief Send a batch of requests and wait for all of them to complete.
+  /// @param[inout] batch Requests to send.
+  /// @param[in] timeout Optional timeout overriding `timeout()`.
+  /// @details
+  /// The whole batch costs one `sendmsg()` and one receive loop, instead of a 
+  /// round trip per request. Replies, ACKs and errors are routed back to their
+  /// request through `nlmsg_seq`.
+  /// @note A socket can run only one dump at a time: a second dump request in
+  ///       the same batch completes with `-EBUSY`.
+  void transact(std::span<nlrequest_t> batch,
+                std::optional<std::chrono::milliseconds> timeout = {});
+
+  /// @brief Non-throwing version of `transact()`.
+  [[nodiscard]] expected<> try_transact(std::span<nlrequest_t> batch,
+    std::optional<std::chrono::milliseconds> timeout = {}) noexcept;
+
+  /// @brief Send a request without waiting for its reply.
+  /// @param[in] msg Netlink message to send.
+  /// @param[in] fun Optional valid-message handler.
+  /// @param[in] arg Optional valid-message handler parameter.
+  /// @param[in] done Completion, invoked by `dispatch()` on ACK, DONE or error.
+  /// @returns The sequence number assigned to the request.
+  /// @throws `std::system_error` When `nl_send_auto()` fails.
+  /// @note `fun`, `arg` and `done` must stay valid until completion, and 
+  ///       `done` must not throw.
+  uint32_t send_async(nlmsg_t const& msg, nl_recvmsg_msg_cb_t fun, void* arg,
+                      nlcompletion_t done);
+
+  /// @brief Non-throwing version of `send_async()`.
+  [[nodiscard]] expected<uint32_t> 
+    try_send_async(nlmsg_t const& msg, nl_recvmsg_msg_cb_t fun, void* arg, 
+                   nlcompletion_t done) noexcept;
+
+  /// @brief Send a request without waiting for its ACK.
+  /// @param[in] msg Netlink message to send.
+  /// @returns The sequence number assigned to the request.
+  /// @throws `std::system_error` When `nl_send_auto()` fails.
+  /// @details The ACK or the error is collected later, by `drain()`, 
+  ///          `flush()`, `dispatch()` or any blocking receive on this socket, 
+  ///          and reported to the ack handler or to the error queue.
+  uint32_t send_nowait(nlmsg_t const& msg);
+
+  /// @brief Non-throwing version of `send_nowait()`.
+  [[nodiscard]] expected<uint32_t> try_send_nowait(nlmsg_t const& msg) noexcept;
+
+  /// @brief Process the replies already received, without waiting.
+  /// @throws `std::system_error` When `poll()` or `nl_recvmsgs_report()` fails.
+  void drain();
+
+  /// @brief Non-throwing version of `drain()`.
+  [[nodiscard]] expected<> try_drain() noexcept;
+
+  /// @brief Wait until every asynchronous request has completed.
+  /// @param[in] timeout Optional timeout overriding `timeout()`.
+  /// @throws `std::system_error` When a receive fails or the deadline expires.
+  void flush(std::optional<std::chrono::milliseconds> timeout = {});
+
+  /// @brief Non-throwing version of `flush()`.
+  [[nodiscard]] expected<> 
+    try_flush(std::optional<std::chrono::milliseconds> timeout = {}) noexcept;
+
+  /// @brief Process every reply available on the socket.
+  /// @throws `std::system_error` When `nl_recvmsgs_report()` fails.
+  /// @details Replies of asynchronous requests are routed by sequence number 
+  ///          and their completion is invoked. On a non-blocking socket this 
+  ///          never waits, so it can be driven by an `nlreactor_t`.
+  void dispatch();
+
+  /// @brief Non-throwing version of `dispatch()`.
+  [[nodiscard]] expected<> try_dispatch() noexcept;
+
+  /// @brief Fail every asynchronous request still in flight.
+  /// @param[in] error Negated errno passed to the completions, e.g. 
+  ///            `-ETIMEDOUT`.
+  /// @details Requests sent by the completions are left in flight. The late
+  ///          replies of the failed requests are skipped.
+  void expire(int error) noexcept;
 
 private:
 
@@ -84,8 +457,30 @@ private:
   friend void swap(nlsocket_t& lhs, nlsocket_t& rhs) noexcept
   {
     std::swap(lhs.socketPtr_, rhs.socketPtr_);
+    std::swap(lhs.connected_, rhs.connected_);
+    swap(lhs.callback_, rhs.callback_);
+    std::swap(lhs.inflight_, rhs.inflight_);
+    std::swap(lhs.nonblocking_, rhs.nonblocking_);
+    std::swap(lhs.protocol_, rhs.protocol_);
+    std::swap(lhs.timeout_, rhs.timeout_);
+    std::swap(lhs.rcvtimeo_, rhs.rcvtimeo_);
+    std::swap(lhs.seq_expect_, rhs.seq_expect_);
+    std::swap(lhs.msg_buf_size_, rhs.msg_buf_size_);
+    std::swap(lhs.autotune_, rhs.autotune_);
+    std::swap(lhs.ack_handler_, rhs.ack_handler_);
+    std::swap(lhs.errors_, rhs.errors_);
+    std::swap(lhs.rawBuf_, rhs.rawBuf_);
+    std::swap(lhs.rawSize_, rhs.rawSize_);
+    std::swap(lhs.iov_, rhs.iov_);
+    std::swap(lhs.last_cmd_, rhs.last_cmd_);
+    lhs.bind_handlers();
+    rhs.bind_handlers();
   }
 
+  /// @brief Point the default handlers of `callback_` to this object.
+  /// @note Called again after a move, since handlers receive `this` as arg.
+  void bind_handlers() noexcept;
+
 //* Netlink callbacks / / / / / / / / / / / / / / / / / / / / / / / / / / / / / 
 
   /// @brief Default error handler.
@@ -97,11 +492,112 @@ private:
   /// @brief default ack handler.
   static int ack_handler(nl_msg*, void*) noexcept;
 
+  /// @brief Default sequence check. Completes the replies of asynchronous 
+  ///        requests and skips those of expired requests.
+  static int seq_handler(nl_msg*, void*) noexcept;
+
+  /// @brief Route every reply to `find_request()` through the batch handlers.
+  void install_seq_handlers() noexcept;
+
+  /// @brief Transmit a message with a given sequence number.
+  [[nodiscard]] expected<> try_send_seq(nlmsg_t const& msg, uint32_t seq) noexcept;
+
+  /// @brief Returns the deadline of a receive, if any.
+  /// @param[in] timeout Timeout of the call, `timeout()` if empty.
+  std::optional<std::chrono::steady_clock::time_point> 
+    deadline_of(std::optional<std::chrono::milliseconds> timeout) const noexcept;
+
+  /// @brief Apply a timeout as `SO_RCVTIMEO`, if not already applied.
+  /// @returns `0` or the `setsockopt()` errno.
+  int apply_rcvtimeo(std::chrono::milliseconds timeout) noexcept;
+
+  /// @brief Grow the buffers after a truncated message or an overrun.
+  /// @param[in] err Error returned by `nl_recvmsgs()`.
+  /// @returns `EMSGSIZE` or `ENOBUFS` if the buffers grew, otherwise `0`.
+  int grow_buffers(int err) noexcept;
+
+  /// @brief Allocate the `recv_raw()` buffer, if not large enough.
+  /// @returns `0` or `ENOMEM`.
+  int reserve_raw() noexcept;
+
+  /// @brief Read and process a datagram of the reply to the last request.
+  /// @returns true once the reply is complete.
+  [[nodiscard]] expected<bool> try_recv_datagram(nlview_cb_t fun, void* arg,
+    std::optional<std::chrono::steady_clock::time_point> deadline) noexcept;
+
+  /// @brief Process a datagram read by `try_recv_raw()`.
+  void process_raw(std::size_t len, nlview_cb_t fun, void* arg) noexcept;
+
+  /// @brief Make the error of a failed `nl_recvmsgs()`.
+  error recv_error(int err, int cmd) noexcept;
+
+  /// @brief Block until the socket is readable or the deadline expires.
+  /// @returns `0`, `ETIMEDOUT` or the `poll()` errno.
+  /// @note A blocking socket without deadline does not poll at all.
+  int wait_readable(std::optional<std::chrono::steady_clock::time_point> 
+                      deadline = {}) const noexcept;
+
+  /// @brief Returns the genl command or the message type of a message.
+  int command_of(nlmsg_t const& msg) const noexcept;
+
+  /// @brief Find the batch or asynchronous request with a sequence number.
+  nlrequest_t* find_request(uint32_t seq) noexcept;
+
+  /// @brief Complete a request, invoking its completion if asynchronous.
+  /// @details An asynchronous request without completion is reported to the
+  ///          ack handler or to the error queue.
+  void complete(nlrequest_t& request, int error) noexcept;
+
+  /// @brief Report the outcome of a request sent without waiting.
+  void report(nlack_t const& ack) noexcept;
+
+  /// @brief Batch valid-message handler. Forwards to the request handler.
+  static int batch_valid_handler(nl_msg*, void*) noexcept;
+
+  /// @brief Batch error handler. Completes a request with an error.
+  static int batch_error_handler(sockaddr_nl*, nlmsgerr*, void*) noexcept;
+
+  /// @brief Batch finish and ack handler. Completes a request.
+  static int batch_done_handler(nl_msg*, void*) noexcept;
+
+  /// @brief Batch sequence check. Replies are matched by `find_request()`.
+  static int batch_seq_handler(nl_msg*, void*) noexcept;
+
 //* Representation / / / / / / / / / / / / / / / / / / / / / / / / / / / / / / /
 
   struct nl_sock* socketPtr_{}; // Underlying pointer
   bool connected_{};  // Connection status
-  nlcb_t callback_;   // Callback to invoke after received a response
+  nlcb_t callback_;   // Persistent callback set shared by all requests
+  int status_{};      // Set by the default handlers: >0 pending, 0 done, <0 error
+
+  std::span<nlrequest_t> batch_;  // Requests in flight during `recv_batch()`
+  std::size_t pending_{};         // Requests of `batch_` not yet completed
+  std::vector<iovec> iov_;        // Reused `sendmsg()` scatter list
+
+  std::vector<nlrequest_t> inflight_; // Asynchronous requests not completed
+  bool nonblocking_{};                // Non-blocking mode
+
+  netlink_protocol_e protocol_{};     // Connected protocol
+  int last_cmd_{};                    // Command of the last sent message
+
+  std::chrono::milliseconds timeout_{no_timeout};   // Default receive timeout
+  std::chrono::milliseconds rcvtimeo_{no_timeout};  // Applied `SO_RCVTIMEO`
+  uint32_t seq_expect_{};   // Sequence number of the last sent message
+
+  std::size_t msg_buf_size_{};  // libnl message buffer size, 0 if default
+  bool autotune_{};             // Grow the buffers on truncation or overrun
+
+  nlack_handler_t ack_handler_;   // Outcomes of the no-wait requests
+  std::vector<nlack_t> errors_;   // Errors of the no-wait requests, if no handler
+
+  /// @brief Deleter of the `std::aligned_alloc()` receive buffer.
+  struct free_deleter_t
+  {
+    void operator()(std::byte* ptr) const noexcept { std::free(ptr); }
+  };
+
+  std::unique_ptr<std::byte[], free_deleter_t> rawBuf_; // `recv_raw()` buffer
+  std::size_t rawSize_{};                               // Its size
 };
 
 
@@ -0,0 +1,204 @@
+#if !defined(NLPP_TASK_HPP)
+#define NLPP_TASK_HPP
+
+
+/**
+ * @file task.hpp
+ * Contains the `task` coroutine type definition.
+ */
+
+
+#include <coroutine>
+#include <exception>
+#include <optional>
+#include <utility>
+
+
+namespace nlpp {
+
+
+template <typename T = void> class task;
+
+
+namespace detail {
+
+
+/// @brief Common part of a `task` promise: continuation and exception.
+struct task_promise_base
+{
+  /// @brief Resumes the awaiting coroutine when the task completes.
+  struct final_awaiter
+  {
+    bool await_ready() const noexcept { return false; }
+
+    template <typename Promise>
+    std::coroutine_handle<>
+    await_suspend(std::coroutine_handle<Promise> handle) const noexcept {
+      return handle.promise().continuation_;
+    }
+
+    void await_resume() const noexcept {}
+  };
+
+  std::suspend_always initial_suspend() const noexcept { return {}; }
+  final_awaiter final_suspend() const noexcept { return {}; }
+
+  void unhandled_exception() noexcept { exception_ = std::current_exception(); }
+
+  std::coroutine_handle<> continuation_{std::noop_coroutine()};
+  std::exception_ptr exception_;
+};
+
+
+/// @brief Promise of a `task` returning a value.
+template <typename T>
+struct task_promise : task_promise_base
+{
+  task<T> get_return_object() noexcept;
+
+  template <typename U> void return_value(U&& value) {
+    value_.emplace(std::forward<U>(value));
+  }
+
+  T result()
+  {
+    if(exception_) {
+      std::rethrow_exception(exception_);
+    }
+    return std::move(*value_);
+  }
+
+  std::optional<T> value_;
+};
+
+
+/// @brief Promise of a `task` returning nothing.
+template <>
+struct task_promise<void> : task_promise_base
+{
+  task<void> get_return_object() noexcept;
+
+  void return_void() const noexcept {}
+
+  void result() const
+  {
+    if(exception_) {
+      std::rethrow_exception(exception_);
+    }
+  }
+};
+
+
+};  // end namespace detail
+
+
+/**
+ * @brief Lazy coroutine returning a `T`.
+ *
+ * @details
+ * The coroutine starts when it is awaited, or when `start()` is called for a
+ * top-level task. Exceptions thrown inside the coroutine are rethrown by
+ * `result()` or by `co_await`.
+ *
+ * \code
+ * nlpp::task<> hop(nlpp::NetlinkGeneric& genl) {
+ *   auto info = co_await genl.async_get_interface(nlpp::if_index_t{3});
+ *   ...
+ * }
+ * \endcode
+ */
+template <typename T>
+class task
+{
+public:
+
+  using promise_type = detail::task_promise<T>; ///< Coroutine promise type
+
+  /// @brief Construct an empty task.
+  task() = default;
+
+  /// @brief Take ownership of a coroutine.
+  explicit task(std::coroutine_handle<promise_type> handle) noexcept
+  : handle_{handle} {}
+
+  /// @brief Move ctor.
+  task(task&& other) noexcept : handle_{std::exchange(other.handle_, {})} {}
+
+  /// @brief Move assignment operator.
+  /// @returns `*this`.
+  task& operator=(task&& rhs) noexcept
+  {
+    task moved{std::move(rhs)};
+    std::swap(handle_, moved.handle_);
+
+    return *this;
+  }
+
+  /// @brief Destroy the coroutine frame.
+  ~task()
+  {
+    if(handle_) {
+      handle_.destroy();
+    }
+  }
+
+  /// @brief Start a top-level task.
+  /// @note It runs until its first suspension point.
+  void start() { handle_.resume(); }
+
+  /// @brief Returns true if the coroutine has completed.
+  [[nodiscard]] bool done() const noexcept { return !handle_ || handle_.done(); }
+
+  /// @brief Returns the coroutine result.
+  /// @pre `done()` must be true.
+  /// @throws Any exception thrown by the coroutine.
+  T result() { return handle_.promise().result(); }
+
+  /// @brief Start the task and resume the awaiting coroutine on completion.
+  auto operator co_await() && noexcept
+  {
+    struct awaiter
+    {
+      std::coroutine_handle<promise_type> handle;
+
+      bool await_ready() const noexcept { return !handle || handle.done(); }
+
+      std::coroutine_handle<>
+      await_suspend(std::coroutine_handle<> awaiting) const noexcept
+      {
+        handle.promise().continuation_ = awaiting;
+        return handle;
+      }
+
+      T await_resume() { return handle.promise().result(); }
+    };
+
+    return awaiter{handle_};
+  }
+
+private:
+
+  std::coroutine_handle<promise_type> handle_; // owned coroutine
+};
+
+
+//* function template definitions / / / / / / / / / / / / / / / / / / / / / / /
+
+
+template <typename T>
+task<T> detail::task_promise<T>::get_return_object() noexcept
+{
+  return task<T>{std::coroutine_handle<task_promise<T>>::from_promise(*this)};
+}
+
+
+inline task<void> detail::task_promise<void>::get_return_object() noexcept
+{
+  return task<void>{std::coroutine_handle<task_promise<void>>::from_promise(*this)};
+}
+
+
+};  // end namespace nlpp
+
+
+#endif // NLPP_TASK_HPP
@@ -12,24 +12,78 @@
 #include "nlpp/NetlinkRoute.hpp"
 #include "nlpp/NetlinkGeneric.hpp"
 
+#include <chrono>
+#include <memory>
+#include <optional>
 #include <string>
+#include <utility>
 
 
 namespace nlpp {
 
 
+/// @brief Immutable state of a `WifiDevice`, fetched in one round trip per
+///        subsystem.
+struct wifi_snapshot_t
+{
+  std::string     name;       ///< From the rtnl link
+  if_flags_t      flags;      ///< From the rtnl link
+  if_operstate_e  operstate;  ///< From the rtnl link
+  dev_info_t      info;       ///< From `NL80211_CMD_GET_INTERFACE`
+  std::chrono::steady_clock::time_point taken; ///< When it was fetched
+
+  /// @brief Returns true if the link is UP.
+  [[nodiscard]] bool is_up() const noexcept
+  {
+    return flags.get().to_ulong() & std::to_underlying(if_flag_e::up);
+  }
+};
+
+
 /** 
  * @brief Let you easily put wlan adapter to monitor mode and change channels.
  * @pre Device must have an index!
+ *
+ * @details
+ * The getters read a `wifi_snapshot_t`, fetched again only when it is older
+ * than `max_age()`: a sequence of getters costs one round trip per subsystem.
+ * A zero age fetches on every getter, i.e. two round trips each. The setters
+ * drop the snapshot, so the changes made through this object are always seen.
  */
 class WifiDevice
 {
 public:
 
+  /// @brief Default staleness bound of the getters.
+  static constexpr std::chrono::milliseconds default_max_age{100};
+
   /// @brief Construct a device issuing a request directly to the kernel.
   /// @param[in] if_name Wireless device name.
   /// @param[in] if_type Interface type to set.
-  WifiDevice(std::string const&, nlpp::if_type_e = {});
+  /// @param[in] max_age Staleness bound of the getters.
+  WifiDevice(std::string const&, nlpp::if_type_e = {}, 
+             std::chrono::milliseconds max_age = default_max_age);
+
+  /// @brief Returns the staleness bound of the getters.
+  [[nodiscard]] std::chrono::milliseconds max_age() const noexcept 
+  { 
+    return this->max_age_; 
+  }
+
+  /// @brief Set the staleness bound of the getters.
+  void set_max_age(std::chrono::milliseconds max_age) noexcept 
+  { 
+    this->max_age_ = max_age; 
+  }
+
+  /// @brief Fetch the link and the nl80211 interface state, once each.
+  /// @param[in] parallel True to overlap the two requests on two threads.
+  /// @returns The new snapshot, also read by the getters.
+  /// @throws `std::system_error` when a request fails.
+  [[nodiscard]] std::shared_ptr<wifi_snapshot_t const> snapshot(bool parallel = false);
+
+  /// @brief Returns the last snapshot, fetched again if older than `max_age()`.
+  [[nodiscard]] std::shared_ptr<wifi_snapshot_t const> current();
 
 // Getters / / / / / / / / / / / / / / / / / / / / / / / / / / / / / / / / / / /
 
@@ -37,7 +91,8 @@ public:
   [[nodiscard]] std::string name();
 
   /// @brief Get link status fom a `rtnl_link_t` obj and returns if it is UP.
-  [[nodiscard]] bool is_up() noexcept;
+  /// @throws `std::system_error` when the snapshot cannot be fetched.
+  [[nodiscard]] bool is_up();
 
   /// @brief Retrieve the interface type from a `rtnl_link_t` object.
   [[nodiscard]] nlpp::if_type_e type();
@@ -78,6 +133,9 @@ private:
   nlpp::if_index_t     ifindex_;    // this device index
   nlpp::NetlinkRoute   nlroute_;    // connection to rtnl subsystem
   nlpp::NetlinkGeneric nlgeneric_;  // connection to genl subsystem
+
+  std::chrono::milliseconds max_age_;  // staleness bound of the getters
+  std::shared_ptr<wifi_snapshot_t const> snapshot_; // read by the getters
 };
 
 
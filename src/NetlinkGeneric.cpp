@@ -1,6 +1,9 @@
 #include "NetlinkGeneric.hpp"
 
 
+#include "genl_family_cache_t.hpp"
+#include "nlattr_index_t.hpp"
+#include "nlattr_map.hpp"
 #include "nlattr_t.hpp"
 #include "nlpp.hpp"
 
@@ -8,175 +11,1172 @@
 #include <netlink/msg.h>
 #include <linux/nl80211.h>
 
+#include <algorithm>
 #include <stdexcept>
 #include <system_error>
 #include <cstdarg>
+#include <memory>
+#include <new>
+#include <vector>
 
 
 using namespace nlpp;
 
 
 NetlinkGeneric::NetlinkGeneric()
+: pool_{std::make_unique<nlmsg_pool_t>(request_msg_size)}
 {
   socket_.connect(netlink_protocol_e::generic);
 
-  nl80211_id_ = genl_ctrl_resolve(socket_.get_pointer(), "nl80211");
-  if(nl80211_id_ < 0) {
-    throw 
-      std::system_error{nl80211_id_, std::system_category(), "nl80211 not found"};
+  // a controller round trip for the first object of the process only
+  nl80211_id_ = genl_family_cache_t::instance().resolve(socket_, "nl80211").id;
+
+  // once per object: kernels before 3.10 lack the command and any feature
+  if(auto features = this->try_probe_protocol_features(); features) {
+    protocol_features_ = *features;
   }
+
+  // best effort: kernels before 4.20 ignore the dump filters anyway
+  [[maybe_unused]] auto const strict = socket_.try_set_strict_check(true);
 }
 
 
-// TODO: fai in modo che il costruttore di `if_index_t` possa fallire.
-dev_info_t NetlinkGeneric::get_interface(if_index_t ifindex)
+namespace {
+
+/// @brief Returns the name of the operation issuing a command.
+constexpr char const* what_of(nl80211_commands cmd) noexcept
+{
+  switch(cmd)
+  {
+    case NL80211_CMD_GET_INTERFACE: return "get_interface";
+    case NL80211_CMD_SET_INTERFACE: return "set_if_type";
+    case NL80211_CMD_GET_WIPHY: return "get_phy";
+    case NL80211_CMD_SET_WIPHY: return "set_if_frequency";
+    case NL80211_CMD_GET_PROTOCOL_FEATURES: return "get_protocol_features";
+    default: return "nl80211";
+  }
+}
+
+
+/// @brief Throws a `std::system_error` for a negated errno, if any.
+void throw_if_error(int err, nl80211_commands cmd)
+{
+  if(err) {
+    throw_error(error::from_errno(err, cmd, what_of(cmd)));
+  }
+}
+
+
+/// @brief Returns the nl80211 command of a message.
+nl80211_commands command_of(nlmsg_t const& msg) noexcept
+{
+  auto const* gnlh = reinterpret_cast<struct genlmsghdr const*>(
+    nlmsg_data(nlmsg_hdr(msg.get_pointer())));
+
+  return static_cast<nl80211_commands>(gnlh->cmd);
+}
+
+
+/// @brief Run a dump again if the auto-tune mode grew the socket buffers.
+/// @param[in] socket Socket of the dump.
+/// @param[in] dump Callable that issues the dump.
+template <typename Dump>
+auto retry_overrun(nlsocket_t const& socket, Dump dump)
+{
+  auto result = dump();
+
+  if(!result && socket.autotune() 
+    && (result.error().code == std::errc::no_buffer_space 
+      || result.error().code == std::errc::message_size)) {
+    result = dump();  // the previous dump lost messages
+  }
+
+  return result;
+}
+
+
+/// @brief Streaming dump in progress on a socket.
+/// @details The kernel refuses a new dump with `EBUSY` while one runs on the
+///          socket: a dump abandoned halfway is read to its end and 
+///          discarded, at the latest when the guard is destroyed.
+struct dump_guard_t
+{
+  nlsocket_t& socket;
+  bool running{true};  // a failed receive ends the dump as well
+
+  /// @brief Read and discard the rest of the dump.
+  expected<> drain() noexcept
+  {
+    while(this->running)
+    {
+      auto received = socket.try_recv_raw_next();
+      if(!received)
+      {
+        this->running = false;
+        return std::unexpected{received.error()};
+      }
+      this->running = !*received;
+    }
+
+    return {};
+  }
+
+  ~dump_guard_t() { [[maybe_unused]] auto const drained = this->drain(); }
+};
+
+
+/// @brief Returns the index of a device, or `ENODEV` if it does not exist.
+expected<uint32_t> index_of(std::string const& ifname, nl80211_commands cmd)
+{
+  uint32_t const ifindex = if_nametoindex(ifname.data());
+  if(ifindex == 0) {
+    return std::unexpected{error::from_errno(ENODEV, cmd, "if_nametoindex")};
+  }
+
+  return ifindex;
+}
+
+
+/// @brief Parser of the `NL80211_CMD_GET_INTERFACE` replies.
+/// @details Add a `dev_info_t` field by mapping it here.
+using dev_info_map = nlattr_map_t<dev_info_t,
+  nlfield_t<NL80211_ATTR_IFINDEX, &dev_info_t::if_index>,
+  nlfield_t<NL80211_ATTR_IFNAME, &dev_info_t::if_name>,
+  nlfield_t<NL80211_ATTR_WDEV, &dev_info_t::wdev>,
+  nlfield_t<NL80211_ATTR_MAC, &dev_info_t::mac_address, nldecode_mac_t>,
+  nlfield_t<NL80211_ATTR_SSID, &dev_info_t::ssid, nldecode_bytes_t>,
+  nlfield_t<NL80211_ATTR_IFTYPE, &dev_info_t::type>,
+  nlfield_t<NL80211_ATTR_WIPHY, &dev_info_t::wiphy_index>,
+  nlfield_t<NL80211_ATTR_WIPHY_FREQ, &dev_info_t::wiphy_freq>,
+  nlfield_t<NL80211_ATTR_CHANNEL_WIDTH, &dev_info_t::channel_width>>;
+
+
+/// @brief Append the channels of a `NL80211_BAND_ATTR_FREQS` nest.
+void decode_channels(struct nlattr* freqs, wiphy_channels_t& channels, 
+                     band_capability_t& band)
+{
+  struct nlattr* item;
+  int rem;
+
+  nla_for_each_nested(item, freqs, rem)
+  {
+    auto const tb = nlattr_index_t<
+      NL80211_FREQUENCY_ATTR_FREQ,
+      NL80211_FREQUENCY_ATTR_DISABLED,
+      NL80211_FREQUENCY_ATTR_NO_IR,
+      NL80211_FREQUENCY_ATTR_RADAR,
+      NL80211_FREQUENCY_ATTR_INDOOR_ONLY,
+      NL80211_FREQUENCY_ATTR_NO_HT40_MINUS,
+      NL80211_FREQUENCY_ATTR_NO_HT40_PLUS,
+      NL80211_FREQUENCY_ATTR_NO_80MHZ,
+      NL80211_FREQUENCY_ATTR_NO_160MHZ,
+      NL80211_FREQUENCY_ATTR_MAX_TX_POWER>::of_nested(item);
+
+    auto* attr = tb.get<NL80211_FREQUENCY_ATTR_FREQ>();
+    auto const freq = attr ? nla_read<uint32_t>(attr) : std::nullopt;
+    if(!freq) {
+      continue;
+    }
+
+    uint8_t flags = 0;
+    auto flag = [&](struct nlattr* attr, channel_flag_e value) {
+      flags |= attr ? static_cast<uint8_t>(value) : 0;
+    };
+    flag(tb.get<NL80211_FREQUENCY_ATTR_DISABLED>(), channel_flag_e::disabled);
+    flag(tb.get<NL80211_FREQUENCY_ATTR_NO_IR>(), channel_flag_e::no_ir);
+    flag(tb.get<NL80211_FREQUENCY_ATTR_RADAR>(), channel_flag_e::radar);
+    flag(tb.get<NL80211_FREQUENCY_ATTR_INDOOR_ONLY>(), channel_flag_e::indoor_only);
+    flag(tb.get<NL80211_FREQUENCY_ATTR_NO_HT40_MINUS>(), channel_flag_e::no_ht40_minus);
+    flag(tb.get<NL80211_FREQUENCY_ATTR_NO_HT40_PLUS>(), channel_flag_e::no_ht40_plus);
+    flag(tb.get<NL80211_FREQUENCY_ATTR_NO_80MHZ>(), channel_flag_e::no_80mhz);
+    flag(tb.get<NL80211_FREQUENCY_ATTR_NO_160MHZ>(), channel_flag_e::no_160mhz);
+
+    uint32_t power = 0;
+    if(auto* max = tb.get<NL80211_FREQUENCY_ATTR_MAX_TX_POWER>()) {
+      power = nla_read<uint32_t>(max).value_or(0);
+    }
+
+    if(band.count == 0) {
+      band.first = static_cast<uint32_t>(channels.size());
+    }
+    ++band.count;
+
+    // the columns grow together
+    channels.freqs.emplace_back(*freq);
+    channels.flags.push_back(flags);
+    channels.max_tx_power.push_back(power);
+
+    // then the bitmaps of the constant time queries
+    channels.supported.insert(frequency_t{*freq});
+    if(!(flags & static_cast<uint8_t>(channel_flag_e::disabled))) {
+      channels.usable.insert(frequency_t{*freq});
+    }
+  }
+}
+
+
+/// @brief Decoder of `NL80211_ATTR_WIPHY_BANDS` into `wiphy_channels_t`.
+/// @details A split dump repeats the nest of a band over many messages, the
+///          rates in one and the channels in the following ones, so a band 
+///          is looked up by its type before it is appended to. The channels
+///          of a band are sent in a row, which keeps its range contiguous.
+struct nldecode_bands_t
+{
+  template <auto Attr>
+  static void decode(struct nlattr* attr, wiphy_channels_t& channels)
+  {
+    struct nlattr* nest;
+    int rem;
+
+    nla_for_each_nested(nest, attr, rem)
+    {
+      auto const type = static_cast<nl80211_band>(nla_type(nest));
+
+      auto found = std::ranges::find(channels.bands, type, &band_capability_t::band);
+      auto& band = found != std::end(channels.bands) 
+        ? *found : channels.bands.emplace_back();
+      band.band = type;
+
+      auto const tb = nlattr_index_t<
+        NL80211_BAND_ATTR_FREQS,
+        NL80211_BAND_ATTR_RATES,
+        NL80211_BAND_ATTR_HT_CAPA,
+        NL80211_BAND_ATTR_VHT_CAPA,
+        NL80211_BAND_ATTR_IFTYPE_DATA>::of_nested(nest);
+
+      if(auto* freqs = tb.get<NL80211_BAND_ATTR_FREQS>()) {
+        decode_channels(freqs, channels, band);
+      }
+
+      if(auto* rates = tb.get<NL80211_BAND_ATTR_RATES>()) {
+        nldecode_each_t<nldecode_path_t<NL80211_BITRATE_ATTR_RATE, 
+          nldecode_append_t<uint32_t>>>::decode<Attr>(rates, band.bitrates);
+      }
+
+      if(auto* ht = tb.get<NL80211_BAND_ATTR_HT_CAPA>()) {
+        nldecode_t<uint16_t>::decode<Attr>(ht, band.ht_capa);
+      }
+
+      if(auto* vht = tb.get<NL80211_BAND_ATTR_VHT_CAPA>()) {
+        nldecode_t<uint32_t>::decode<Attr>(vht, band.vht_capa);
+      }
+
+      // the HE capabilities are per interface type: keep the first ones
+      if(auto* iftypes = tb.get<NL80211_BAND_ATTR_IFTYPE_DATA>(); 
+         iftypes && band.he_phy_capa.empty()) 
+      {
+        struct nlattr* data;
+        int left;
+
+        nla_for_each_nested(data, iftypes, left)
+        {
+          if(auto* he = nla_find(reinterpret_cast<struct nlattr*>(nla_data(data)),
+               nla_len(data), NL80211_BAND_IFTYPE_ATTR_HE_CAP_PHY)) 
+          {
+            auto const* first = reinterpret_cast<uint8_t const*>(nla_data(he));
+            band.he_phy_capa.assign(first, first + nla_len(he));
+            break;
+          }
+        }
+      }
+    }
+  }
+};
+
+
+/// @brief Parser of the `NL80211_CMD_GET_WIPHY` replies, also split ones.
+/// @details Lists are appended to, since a split dump spreads them over 
+///          many messages. `wiphy_index` is the key of the result map.
+using dev_capability_map = nlattr_map_t<dev_capability_t,
+  nlfield_t<NL80211_ATTR_WIPHY_NAME, &dev_capability_t::wiphy_name>,
+  nlfield_t<NL80211_ATTR_SUPPORTED_IFTYPES, &dev_capability_t::iftypes,
+    nldecode_each_t<nldecode_type_bit_t>>,
+  nlfield_t<NL80211_ATTR_WIPHY_BANDS, &dev_capability_t::channels,
+    nldecode_bands_t>,
+  nlfield_t<NL80211_ATTR_SUPPORTED_COMMANDS, &dev_capability_t::cmds,
+    nldecode_each_t<nldecode_bit_t<uint32_t>>>>;
+
+}
+
+
+dev_info_t NetlinkGeneric::decode_interface(nlmsg_view_t msg)
 {
-  std::map<uint32_t,dev_info_t> interface_info; // key is device index
+  dev_info_t dev_info{};
+  dev_info_map::parse_genl(msg, dev_info);
+
+  return dev_info;
+}
+
 
+dev_info_t NetlinkGeneric::get_interface(if_index_t ifindex)
+{
   // check pre-condition
   if(ifindex.get() == 0) {
     throw std::invalid_argument{"interface index cannot be zero"};
   }
 
-  nlmsg_t msg{nl80211_id_, nl80211_commands::NL80211_CMD_GET_INTERFACE};
-  msg.put_attr({nl80211_attrs::NL80211_ATTR_IFINDEX, ifindex.get()});
+  return unwrap(this->try_get_interface(ifindex));
+}
+
+
+expected<dev_info_t> NetlinkGeneric::try_get_interface(if_index_t ifindex)
+{
+  interface_dump_t interface_info;
+
+  auto msg = this->make_get_interface(ifindex);
+  if(!msg) {
+    return std::unexpected{msg.error()};
+  }
+
+  auto sent = this->try_send_msg(*msg, 
+    NetlinkGeneric::get_interface_handler, &interface_info);
+  if(!sent) {
+    return std::unexpected{sent.error()};
+  }
+  if(interface_info.err) {
+    return std::unexpected{error::from_errno(interface_info.err, 
+      NL80211_CMD_GET_INTERFACE, "get_interface")};
+  }
+
+  auto found = interface_info.result.find(ifindex.get());
+  if(found == std::end(interface_info.result)) {
+    return std::unexpected{
+      error::from_errno(ENODEV, NL80211_CMD_GET_INTERFACE, "get_interface")};
+  }
+
+  return std::move(found->second);
+}
+
 
-  this->send_msg(msg, NetlinkGeneric::get_interface_handler, &interface_info);
-  
-  return interface_info.at(ifindex.get());
+std::map<uint32_t,dev_info_t> 
+NetlinkGeneric::get_interfaces(std::span<if_index_t const> if_indexes)
+{
+  return unwrap(this->try_get_interfaces(if_indexes));
+}
+
+
+expected<std::map<uint32_t,dev_info_t>>
+NetlinkGeneric::try_get_interfaces(std::span<if_index_t const> if_indexes)
+{
+  interface_dump_t result;
+
+  std::vector<nlmsg_t> msgs;
+  std::vector<nlrequest_t> batch;
+  msgs.reserve(if_indexes.size());
+  batch.reserve(if_indexes.size());
+
+  for(auto const ifindex: if_indexes)
+  {
+    auto msg = this->make_get_interface(ifindex);
+    if(!msg) {
+      return std::unexpected{msg.error()};
+    }
+
+    batch.push_back({&msgs.emplace_back(std::move(*msg)), 
+      NetlinkGeneric::get_interface_handler, &result});
+  }
+
+  if(auto sent = this->try_send_batch(batch); !sent) {
+    return std::unexpected{sent.error()};
+  }
+  if(result.err) {
+    return std::unexpected{error::from_errno(result.err, 
+      NL80211_CMD_GET_INTERFACE, "get_interfaces")};
+  }
+
+  return std::move(result.result);
 }
 
 
 std::map<uint32_t,dev_info_t> NetlinkGeneric::get_list_interfaces()
 {
-  std::map<uint32_t,dev_info_t> result; // key is device index
+  return unwrap(this->try_get_list_interfaces());
+}
 
-  nlmsg_t msg{
-    nl80211_id_, nl80211_commands::NL80211_CMD_GET_INTERFACE, 768};
 
-  this->send_msg(msg, NetlinkGeneric::get_interface_handler, &result);
+expected<std::map<uint32_t,dev_info_t>> NetlinkGeneric::try_get_list_interfaces()
+{
+  return retry_overrun(socket_, [this] { return this->try_dump_interfaces({}); });
+}
 
-  return result;
+
+std::map<uint32_t,dev_info_t> 
+NetlinkGeneric::get_list_interfaces(wiphy_index_t phy_index)
+{
+  return unwrap(this->try_get_list_interfaces(phy_index));
+}
+
+
+expected<std::map<uint32_t,dev_info_t>> 
+NetlinkGeneric::try_get_list_interfaces(wiphy_index_t phy_index)
+{
+  return retry_overrun(socket_, 
+    [&] { return this->try_dump_interfaces(phy_index); });
 }
 
 
 dev_capability_t NetlinkGeneric::get_phy(wiphy_index_t phy_index)
 {
-  std::map<uint32_t,dev_capability_t> result;
+  return unwrap(this->try_get_phy(phy_index));
+}
+
+
+expected<dev_capability_t> NetlinkGeneric::try_get_phy(wiphy_index_t phy_index)
+{
+  auto result = 
+    retry_overrun(socket_, [&] { return this->try_dump_phys(phy_index); });
+  if(!result) {
+    return std::unexpected{result.error()};
+  }
+
+  auto found = result->find(phy_index.get());
+  if(found == std::end(*result)) {
+    return std::unexpected{
+      error::from_errno(ENODEV, NL80211_CMD_GET_WIPHY, "get_phy")};
+  }
+
+  return std::move(found->second);
+}
+
+
+std::map<uint32_t,dev_capability_t> NetlinkGeneric::get_list_phys()
+{
+  return unwrap(this->try_get_list_phys());
+}
 
-  // first, send `NL80211_CMD_GET_PROTOCOL_FEATURES`
-  bool nl80211_has_split_wiphy{};
 
-  nlmsg_t msg{nl80211_id_,
-    nl80211_commands::NL80211_CMD_GET_PROTOCOL_FEATURES};
+expected<std::map<uint32_t,dev_capability_t>> NetlinkGeneric::try_get_list_phys()
+{
+  return retry_overrun(socket_, [this] { return this->try_dump_phys({}); });
+}
 
-  this->send_msg(msg, &NetlinkGeneric::get_feature_handler, 
-    &nl80211_has_split_wiphy);
 
-  // then, send `NL80211_CMD_GET_WIPHY` with appropriate flags
-  msg = nlmsg_t{nl80211_id_, nl80211_commands::NL80211_CMD_GET_WIPHY};
+void NetlinkGeneric::set_if_type(std::string const& ifname, if_type_e type)
+{
+  unwrap(this->try_set_if_type(ifname, type));
+}
 
-  msg.put_attr({NL80211_ATTR_WIPHY, static_cast<uint32_t>(phy_index.get())} );
 
-  if(nl80211_has_split_wiphy) {
-    msg.put_flag(NL80211_ATTR_SPLIT_WIPHY_DUMP);
-    msg.nlmsg_hdr()->nlmsg_flags |= NLM_F_DUMP;
+expected<> NetlinkGeneric::try_set_if_type(std::string const& ifname, 
+                                           if_type_e type)
+{
+  auto ifindex = index_of(ifname, NL80211_CMD_SET_INTERFACE);
+  if(!ifindex) {
+    return std::unexpected{ifindex.error()};
   }
 
-  this->send_msg(msg, &NetlinkGeneric::get_phy_handler, &result);
+  auto msg = this->make_set_type(*ifindex, type);
+  if(!msg) {
+    return std::unexpected{msg.error()};
+  }
 
-  return result.at(phy_index.get());
+  return this->try_send_msg(*msg);
 }
 
 
-std::map<uint32_t,dev_capability_t> NetlinkGeneric::get_list_phys()
+void NetlinkGeneric::set_if_frequency(std::string const& ifname, 
+                                      frequency_t freq,
+                                      std::optional<std::chrono::milliseconds> timeout)
 {
-  std::map<uint32_t,dev_capability_t> result;
+  unwrap(this->try_set_if_frequency(ifname, freq, timeout));
+}
 
-  // first, send `NL80211_CMD_GET_PROTOCOL_FEATURES`
-  bool nl80211_has_split_wiphy{};
 
-  nlmsg_t msg{nl80211_id_, nl80211_commands::NL80211_CMD_GET_PROTOCOL_FEATURES};
+expected<> NetlinkGeneric::try_set_if_frequency(std::string const& ifname, 
+                                                frequency_t freq,
+                                                std::optional<std::chrono::milliseconds> timeout)
+{
+  auto ifindex = index_of(ifname, NL80211_CMD_SET_WIPHY);
+  if(!ifindex) {
+    return std::unexpected{ifindex.error()};
+  }
+
+  auto msg = this->make_set_frequency(*ifindex, freq);
+  if(!msg) {
+    return std::unexpected{msg.error()};
+  }
+
+  return this->try_send_msg(*msg, {}, {}, timeout);
+}
+
+
+void NetlinkGeneric::set_if_frequency(
+  std::span<std::pair<std::string,frequency_t> const> changes,
+  std::optional<std::chrono::milliseconds> timeout)
+{
+  unwrap(this->try_set_if_frequency(changes, timeout));
+}
 
-  this->send_msg(
-    msg,
-    &NetlinkGeneric::get_feature_handler, 
-    &nl80211_has_split_wiphy);
 
-  // then, send `NL80211_CMD_GET_WIPHY` with appropriate flags
-  msg = nlmsg_t{nl80211_id_, nl80211_commands::NL80211_CMD_GET_WIPHY};
+expected<> NetlinkGeneric::try_set_if_frequency(
+  std::span<std::pair<std::string,frequency_t> const> changes,
+  std::optional<std::chrono::milliseconds> timeout)
+{
+  std::vector<nlmsg_t> msgs;
+  std::vector<nlrequest_t> batch;
+  msgs.reserve(changes.size());
+  batch.reserve(changes.size());
 
-  if(nl80211_has_split_wiphy) 
+  for(auto const& [ifname, freq]: changes) 
   {
-    msg.put_flag(NL80211_ATTR_SPLIT_WIPHY_DUMP);
-    msg.nlmsg_hdr()->nlmsg_flags |= NLM_F_DUMP;
+    auto ifindex = index_of(ifname, NL80211_CMD_SET_WIPHY);
+    if(!ifindex) {
+      return std::unexpected{ifindex.error()};
+    }
+
+    auto msg = this->make_set_frequency(*ifindex, freq);
+    if(!msg) {
+      return std::unexpected{msg.error()};
+    }
+
+    batch.push_back({&msgs.emplace_back(std::move(*msg))});
   }
 
-  this->send_msg(std::move(msg), &NetlinkGeneric::get_phy_handler, &result);
+  return this->try_send_batch(batch, timeout);
+}
 
-  return result;
+
+freq_request_t 
+NetlinkGeneric::prepare_set_if_frequency(std::string const& ifname)
+{
+  return unwrap(this->try_prepare_set_if_frequency(ifname));
 }
 
 
-void NetlinkGeneric::set_if_type(std::string const& ifname, if_type_e type)
+expected<freq_request_t> 
+NetlinkGeneric::try_prepare_set_if_frequency(std::string const& ifname) noexcept
 {
-  uint32_t const ifindex = if_nametoindex(ifname.data());
+  auto ifindex = index_of(ifname, NL80211_CMD_SET_WIPHY);
+  if(!ifindex) {
+    return std::unexpected{ifindex.error()};
+  }
 
-  nlmsg_t msg{nl80211_id_, nl80211_commands::NL80211_CMD_SET_INTERFACE};
+  // not pooled: the request may outlive this object
+  auto msg = this->make_set_frequency(*ifindex, frequency_t{}, false);
+  if(!msg) {
+    return std::unexpected{msg.error()};
+  }
 
-  msg.put_attr(
-    nlattr_t{nl80211_attrs::NL80211_ATTR_IFINDEX, ifindex},
-    nlattr_t{nl80211_attrs::NL80211_ATTR_IFTYPE, static_cast<uint32_t>(type)} );
+  auto freq = msg->try_slot<NL80211_ATTR_WIPHY_FREQ>();
+  if(!freq) {
+    return std::unexpected{freq.error()};
+  }
 
-  this->send_msg(msg);
+  return freq_request_t{std::move(*msg), *freq};
 }
 
 
-void NetlinkGeneric::set_if_frequency(std::string const& ifname, frequency_t freq)
+void NetlinkGeneric::set_if_frequency(freq_request_t& request, frequency_t freq,
+                                      std::optional<std::chrono::milliseconds> timeout)
 {
-  uint32_t const ifindex = if_nametoindex(ifname.data());
+  unwrap(this->try_set_if_frequency(request, freq, timeout));
+}
 
-  nlmsg_t msg{nl80211_id_, nl80211_commands::NL80211_CMD_SET_WIPHY};
 
-  msg.put_attr(
-    nlattr_t{nl80211_attrs::NL80211_ATTR_IFINDEX, ifindex},
-    nlattr_t{
-      nl80211_attrs::NL80211_ATTR_IFTYPE, 
-      static_cast<uint32_t>(if_type_e::monitor)},
-    nlattr_t{nl80211_attrs::NL80211_ATTR_WIPHY_FREQ, freq.get()},
-    nlattr_t{
-      nl80211_attrs::NL80211_ATTR_WIPHY_CHANNEL_TYPE, 
-      static_cast<uint32_t>(nl80211_channel_type::NL80211_CHAN_NO_HT)}
-  );
+expected<> NetlinkGeneric::try_set_if_frequency(
+  freq_request_t& request, frequency_t freq,
+  std::optional<std::chrono::milliseconds> timeout) noexcept
+{
+  request.freq.set(freq.get());
 
-  this->send_msg(std::move(msg));
+  return this->try_send_msg(request.msg, {}, {}, timeout);
 }
 
 
-void NetlinkGeneric::set_if_channel(std::string const& ifname, channel_freq_t chan)
+void NetlinkGeneric::set_if_channel(std::string const& ifname, 
+                                    channel_freq_t chan,
+                                    std::optional<std::chrono::milliseconds> timeout)
 {
-  auto const freq = nlpp::chan2freq(chan);
+  unwrap(this->try_set_if_channel(ifname, chan, timeout));
+}
+
 
-  this->set_if_frequency(ifname, freq);
+expected<> NetlinkGeneric::try_set_if_channel(std::string const& ifname, 
+                                              channel_freq_t chan,
+                                              std::optional<std::chrono::milliseconds> timeout)
+{
+  return this->try_set_if_frequency(ifname, nlpp::chan2freq(chan), timeout);
 }
 
 
-void NetlinkGeneric::send_msg(nlmsg_t const& msg, 
-                              nl_recvmsg_msg_cb_t fun, 
-                              void* arg)
+void NetlinkGeneric::for_each_interface(dev_info_visitor_t const& visitor, 
+                                        std::optional<wiphy_index_t> phy_index)
 {
-  nlcb_t cb{NL_CB_DEFAULT};
-  nlcb_t s_cb{NL_CB_DEFAULT}; // send cb
+  unwrap(this->try_for_each_interface(visitor, phy_index));
+}
+
 
-  // put handler
-  if(fun) {
-    cb.set(NL_CB_VALID, NL_CB_CUSTOM, fun, arg);
+expected<> NetlinkGeneric::try_for_each_interface(
+  dev_info_visitor_t const& visitor, std::optional<wiphy_index_t> phy_index)
+{
+  if(auto started = this->try_start_interfaces(phy_index); !started) {
+    return started;
+  }
+
+  interface_stream_t batch;
+
+  for(dump_guard_t dump{socket_}; dump.running;)
+  {
+    batch.ready.clear();
+
+    auto received = socket_.try_recv_raw_next(
+      &NetlinkGeneric::stream_interface_handler, &batch);
+    dump.running = received && !*received;
+    if(!received) {
+      return std::unexpected{received.error()};
+    }
+    if(batch.err) {
+      return std::unexpected{error::from_errno(batch.err, 
+        NL80211_CMD_GET_INTERFACE, "for_each_interface")};
+    }
+
+    for(auto& dev_info: batch.ready) 
+    {
+      if(!visitor(std::move(dev_info))) {
+        return dump.drain();
+      }
+    }
+  }
+
+  return {};
+}
+
+
+void NetlinkGeneric::for_each_phy(dev_capability_visitor_t const& visitor)
+{
+  unwrap(this->try_for_each_phy(visitor));
+}
+
+
+expected<> NetlinkGeneric::try_for_each_phy(dev_capability_visitor_t const& visitor)
+{
+  if(auto started = this->try_start_phys(); !started) {
+    return started;
+  }
+
+  phy_stream_t stream;
+
+  for(dump_guard_t dump{socket_}; dump.running;)
+  {
+    stream.ready.clear();
+
+    auto received = socket_.try_recv_raw_next(
+      &NetlinkGeneric::stream_phy_handler, &stream);
+    dump.running = received && !*received;
+    if(!received) {
+      return std::unexpected{received.error()};
+    }
+    if(stream.err) {
+      return std::unexpected{
+        error::from_errno(stream.err, NL80211_CMD_GET_WIPHY, "for_each_phy")};
+    }
+
+    if(!dump.running && stream.current) {
+      stream.ready.push_back(*std::exchange(stream.current, {}));
+    }
+
+    for(auto& capability: stream.ready) 
+    {
+      if(!visitor(std::move(capability))) {
+        return dump.drain();
+      }
+    }
   }
 
-  socket_.set_cb(std::move(s_cb));
-  socket_.send_auto(msg);
+  return {};
+}
+
+
+generator<dev_info_t> 
+NetlinkGeneric::stream_interfaces(std::optional<wiphy_index_t> phy_index)
+{
+  unwrap(this->try_start_interfaces(phy_index));
+
+  interface_stream_t batch;
+
+  // destroying the suspended coroutine, e.g. on `break`, drains the dump
+  for(dump_guard_t dump{socket_}; dump.running;)
+  {
+    batch.ready.clear();
+
+    auto received = socket_.try_recv_raw_next(
+      &NetlinkGeneric::stream_interface_handler, &batch);
+    dump.running = received && !*received;
+    unwrap(std::move(received));
+    throw_if_error(batch.err, NL80211_CMD_GET_INTERFACE);
 
-  socket_.recvmsgs(cb);
+    for(auto& dev_info: batch.ready) {
+      co_yield dev_info;
+    }
+  }
+}
+
+
+generator<dev_capability_t> NetlinkGeneric::stream_phys()
+{
+  unwrap(this->try_start_phys());
+
+  phy_stream_t stream;
+
+  for(dump_guard_t dump{socket_}; dump.running;)
+  {
+    stream.ready.clear();
+
+    auto received = socket_.try_recv_raw_next(
+      &NetlinkGeneric::stream_phy_handler, &stream);
+    dump.running = received && !*received;
+    unwrap(std::move(received));
+    throw_if_error(stream.err, NL80211_CMD_GET_WIPHY);
+
+    if(!dump.running && stream.current) {
+      stream.ready.push_back(*std::exchange(stream.current, {}));
+    }
+
+    for(auto& capability: stream.ready) {
+      co_yield capability;
+    }
+  }
+}
+
+
+expected<> NetlinkGeneric::try_send_msg(nlmsg_t const& msg, 
+                                        nl_recvmsg_msg_cb_t fun, 
+                                        void* arg,
+                                        std::optional<std::chrono::milliseconds> timeout) noexcept
+{
+  if(auto sent = socket_.try_send_auto(msg); !sent) {
+    return sent;
+  }
+
+  // reuse the socket callback set
+  return socket_.try_recvmsgs(fun, arg, timeout);
+}
+
+
+expected<std::map<uint32_t,dev_info_t>> 
+NetlinkGeneric::try_dump_interfaces(std::optional<wiphy_index_t> phy_index)
+{
+  interface_dump_t result;
+
+  auto msg = this->make_dump_interfaces(phy_index);
+  if(!msg) {
+    return std::unexpected{msg.error()};
+  }
+
+  auto sent = 
+    this->try_send_msg(*msg, NetlinkGeneric::get_interface_handler, &result);
+  if(!sent) {
+    return std::unexpected{sent.error()};
+  }
+  if(result.err) {
+    return std::unexpected{error::from_errno(result.err, 
+      NL80211_CMD_GET_INTERFACE, "get_list_interfaces")};
+  }
+
+  return std::move(result.result);
+}
+
+
+expected<std::map<uint32_t,dev_capability_t>> 
+NetlinkGeneric::try_dump_phys(std::optional<wiphy_index_t> phy_index)
+{
+  phy_dump_t dump;
+
+  auto msg = this->make_get_wiphy(phy_index, this->split_wiphy());
+  if(!msg) {
+    return std::unexpected{msg.error()};
+  }
+
+  auto sent = this->try_send_msg(*msg, &NetlinkGeneric::get_phy_handler, &dump);
+  if(!sent) {
+    return std::unexpected{sent.error()};
+  }
+  if(dump.err) {
+    return std::unexpected{
+      error::from_errno(dump.err, NL80211_CMD_GET_WIPHY, "get_phy")};
+  }
+
+  return std::move(dump.result);
+}
+
+
+expected<uint32_t> NetlinkGeneric::try_probe_protocol_features()
+{
+  uint32_t features{};
+
+  auto msg = nlmsg_t::try_create(
+    *pool_, nl80211_id_, nl80211_commands::NL80211_CMD_GET_PROTOCOL_FEATURES);
+  if(!msg) {
+    return std::unexpected{msg.error()};
+  }
+
+  auto sent = this->try_send_msg(*msg, &NetlinkGeneric::get_feature_handler, 
+    &features);
+  if(!sent) {
+    return std::unexpected{sent.error()};
+  }
+
+  return features;
+}
+
+
+expected<> 
+NetlinkGeneric::try_start_interfaces(std::optional<wiphy_index_t> phy_index)
+{
+  auto msg = this->make_dump_interfaces(phy_index);
+  if(!msg) {
+    return std::unexpected{msg.error()};
+  }
+
+  return socket_.try_send_auto(*msg);
+}
+
+
+expected<> NetlinkGeneric::try_start_phys()
+{
+  auto msg = this->make_get_wiphy({}, this->split_wiphy());
+  if(!msg) {
+    return std::unexpected{msg.error()};
+  }
+
+  return socket_.try_send_auto(*msg);
+}
+
+
+expected<uint32_t> NetlinkGeneric::post_set_if_type(std::string const& ifname, 
+                                                    if_type_e type)
+{
+  auto ifindex = index_of(ifname, NL80211_CMD_SET_INTERFACE);
+  if(!ifindex) {
+    return std::unexpected{ifindex.error()};
+  }
+
+  auto msg = this->make_set_type(*ifindex, type);
+  if(!msg) {
+    return std::unexpected{msg.error()};
+  }
+
+  return socket_.try_send_nowait(*msg);
+}
+
+
+expected<uint32_t> NetlinkGeneric::post_set_if_frequency(std::string const& ifname, 
+                                                         frequency_t freq)
+{
+  auto ifindex = index_of(ifname, NL80211_CMD_SET_WIPHY);
+  if(!ifindex) {
+    return std::unexpected{ifindex.error()};
+  }
+
+  auto msg = this->make_set_frequency(*ifindex, freq);
+  if(!msg) {
+    return std::unexpected{msg.error()};
+  }
+
+  return socket_.try_send_nowait(*msg);
+}
+
+
+expected<uint32_t> NetlinkGeneric::post_set_if_channel(std::string const& ifname, 
+                                                       channel_freq_t chan)
+{
+  return this->post_set_if_frequency(ifname, nlpp::chan2freq(chan));
+}
+
+
+expected<uint32_t> NetlinkGeneric::post_set_if_frequency(freq_request_t& request,
+                                                         frequency_t freq) noexcept
+{
+  request.freq.set(freq.get());
+
+  return socket_.try_send_nowait(request.msg);
+}
+
+
+expected<uint32_t> NetlinkGeneric::post_set_if_channel(freq_request_t& request,
+                                                       channel_freq_t chan) noexcept
+{
+  return this->post_set_if_frequency(request, nlpp::chan2freq(chan));
+}
+
+
+std::vector<nlack_t> NetlinkGeneric::collect_errors()
+{
+  socket_.drain();
+
+  return socket_.take_errors();
+}
+
+
+void NetlinkGeneric::attach(nlreactor_t& reactor)
+{
+  reactor.add(socket_);
+  reactor_ = &reactor;
+}
+
+
+task<dev_info_t> NetlinkGeneric::async_get_interface(if_index_t ifindex)
+{
+  interface_dump_t interface_info;
+
+  throw_if_error(
+    co_await this->async_send(unwrap(this->make_get_interface(ifindex)), 
+      NetlinkGeneric::get_interface_handler, &interface_info),
+    NL80211_CMD_GET_INTERFACE );
+  throw_if_error(interface_info.err, NL80211_CMD_GET_INTERFACE);
+
+  auto found = interface_info.result.find(ifindex.get());
+  if(found == std::end(interface_info.result)) {
+    throw_if_error(ENODEV, NL80211_CMD_GET_INTERFACE);
+  }
+
+  co_return std::move(found->second);
+}
+
+
+task<std::map<uint32_t,dev_info_t>> NetlinkGeneric::async_get_list_interfaces()
+{
+  interface_dump_t result;
+
+  throw_if_error(
+    co_await this->async_send(unwrap(this->make_dump_interfaces({})),
+      NetlinkGeneric::get_interface_handler, &result),
+    NL80211_CMD_GET_INTERFACE );
+  throw_if_error(result.err, NL80211_CMD_GET_INTERFACE);
+
+  co_return std::move(result.result);
+}
+
+
+task<dev_capability_t> NetlinkGeneric::async_get_phy(wiphy_index_t phy_index)
+{
+  phy_dump_t dump;
+
+  throw_if_error(
+    co_await this->async_send(
+      unwrap(this->make_get_wiphy(phy_index, this->split_wiphy())),
+      &NetlinkGeneric::get_phy_handler, &dump),
+    NL80211_CMD_GET_WIPHY );
+  throw_if_error(dump.err, NL80211_CMD_GET_WIPHY);
+
+  auto found = dump.result.find(phy_index.get());
+  if(found == std::end(dump.result)) {
+    throw_if_error(ENODEV, NL80211_CMD_GET_WIPHY);
+  }
+
+  co_return std::move(found->second);
+}
+
+
+task<std::map<uint32_t,dev_capability_t>> NetlinkGeneric::async_get_list_phys()
+{
+  phy_dump_t dump;
+
+  throw_if_error(
+    co_await this->async_send(
+      unwrap(this->make_get_wiphy({}, this->split_wiphy())),
+      &NetlinkGeneric::get_phy_handler, &dump),
+    NL80211_CMD_GET_WIPHY );
+  throw_if_error(dump.err, NL80211_CMD_GET_WIPHY);
+
+  co_return std::move(dump.result);
+}
+
+
+task<> NetlinkGeneric::async_set_if_type(std::string const& ifname, 
+                                         if_type_e type)
+{
+  // build the message now: `ifname` may not outlive the coroutine
+  auto const ifindex = unwrap(index_of(ifname, NL80211_CMD_SET_INTERFACE));
+
+  return this->async_request(unwrap(this->make_set_type(ifindex, type)));
+}
+
+
+task<> NetlinkGeneric::async_set_if_frequency(std::string const& ifname, 
+                                              frequency_t freq)
+{
+  auto const ifindex = unwrap(index_of(ifname, NL80211_CMD_SET_WIPHY));
+
+  return this->async_request(unwrap(this->make_set_frequency(ifindex, freq)));
+}
+
+
+task<> NetlinkGeneric::async_set_if_channel(std::string const& ifname, 
+                                            channel_freq_t chan)
+{
+  return this->async_set_if_frequency(ifname, nlpp::chan2freq(chan));
+}
+
+
+nlreactor_t::request_awaiter NetlinkGeneric::async_send(nlmsg_t msg, 
+                                                        nl_recvmsg_msg_cb_t fun, 
+                                                        void* arg)
+{
+  if(!reactor_) {
+    throw std::logic_error{"NetlinkGeneric is not attached to a reactor"};
+  }
+
+  return reactor_->async_send(socket_, std::move(msg), fun, arg);
+}
+
+
+task<> NetlinkGeneric::async_request(nlmsg_t msg)
+{
+  auto const cmd = command_of(msg);
+
+  throw_if_error(co_await this->async_send(std::move(msg)), cmd);
+}
+
+
+expected<> NetlinkGeneric::try_send_batch(
+  std::span<nlrequest_t> batch,
+  std::optional<std::chrono::milliseconds> timeout) noexcept
+{
+  if(auto sent = socket_.try_transact(batch, timeout); !sent) {
+    return sent;
+  }
+
+  auto failed = std::ranges::find_if(batch, [](auto& r) { return r.error; });
+
+  if(failed != std::end(batch)) 
+  {
+    auto const cmd = command_of(*failed->msg);
+
+    return std::unexpected{error::from_errno(failed->error, cmd, what_of(cmd))};
+  }
+
+  return {};
+}
+
+
+expected<nlmsg_t> NetlinkGeneric::make_get_interface(if_index_t ifindex) noexcept
+{
+  // check pre-condition
+  if(ifindex.get() == 0) {
+    return std::unexpected{
+      error::from_errno(EINVAL, NL80211_CMD_GET_INTERFACE, "get_interface")};
+  }
+
+  auto msg = nlmsg_t::try_create(
+    *pool_, nl80211_id_, nl80211_commands::NL80211_CMD_GET_INTERFACE);
+  if(!msg) {
+    return msg;
+  }
+
+  if(auto put = msg->try_put<NL80211_ATTR_IFINDEX>(ifindex.get()); !put) {
+    return std::unexpected{put.error()};
+  }
+
+  return msg;
+}
+
+
+expected<nlmsg_t> 
+NetlinkGeneric::make_dump_interfaces(std::optional<wiphy_index_t> phy_index) noexcept
+{
+  auto msg = nlmsg_t::try_create(
+    *pool_, nl80211_id_, nl80211_commands::NL80211_CMD_GET_INTERFACE, NLM_F_DUMP);
+  if(!msg) {
+    return msg;
+  }
+
+  // the kernel filters the dump by wiphy
+  if(phy_index) 
+  {
+    auto put = 
+      msg->try_put<NL80211_ATTR_WIPHY>(static_cast<uint32_t>(phy_index->get()));
+    if(!put) {
+      return std::unexpected{put.error()};
+    }
+  }
+
+  return msg;
+}
+
+
+expected<nlmsg_t> 
+NetlinkGeneric::make_get_wiphy(std::optional<wiphy_index_t> phy_index,
+                               bool split) noexcept
+{
+  auto msg = nlmsg_t::try_create(
+    *pool_, nl80211_id_, nl80211_commands::NL80211_CMD_GET_WIPHY);
+  if(!msg) {
+    return msg;
+  }
+
+  // the kernel filters the split dump by wiphy
+  if(phy_index) 
+  {
+    auto put = 
+      msg->try_put<NL80211_ATTR_WIPHY>(static_cast<uint32_t>(phy_index->get()));
+    if(!put) {
+      return std::unexpected{put.error()};
+    }
+  }
+
+  if(split) 
+  {
+    if(auto put = msg->try_put<NL80211_ATTR_SPLIT_WIPHY_DUMP>(); !put) {
+      return std::unexpected{put.error()};
+    }
+    msg->nlmsg_hdr()->nlmsg_flags |= NLM_F_DUMP;
+  }
+
+  return msg;
+}
+
+
+expected<nlmsg_t> NetlinkGeneric::make_set_type(uint32_t ifindex, 
+                                                 if_type_e type) noexcept
+{
+  auto msg = nlmsg_t::try_create(
+    *pool_, nl80211_id_, nl80211_commands::NL80211_CMD_SET_INTERFACE);
+  if(!msg) {
+    return msg;
+  }
+
+  auto put = msg->try_put<NL80211_ATTR_IFINDEX>(ifindex);
+  if(put) {
+    put = msg->try_put<NL80211_ATTR_IFTYPE>(static_cast<uint32_t>(type));
+  }
+  if(!put) {
+    return std::unexpected{put.error()};
+  }
+
+  return msg;
+}
+
+
+expected<nlmsg_t> NetlinkGeneric::make_set_frequency(uint32_t ifindex, 
+                                                     frequency_t freq,
+                                                     bool pooled) noexcept
+{
+  auto msg = pooled 
+    ? nlmsg_t::try_create(*pool_, nl80211_id_, NL80211_CMD_SET_WIPHY)
+    : nlmsg_t::try_create(nl80211_id_, NL80211_CMD_SET_WIPHY);
+  if(!msg) {
+    return msg;
+  }
+
+  // encoded at compile time: this is the hot path of a channel hopper
+  auto put = msg->try_put<NL80211_ATTR_IFINDEX>(ifindex);
+  if(put) {
+    put = msg->try_put<NL80211_ATTR_IFTYPE>(
+      static_cast<uint32_t>(if_type_e::monitor));
+  }
+  if(put) {
+    put = msg->try_put<NL80211_ATTR_WIPHY_FREQ>(freq.get());
+  }
+  if(put) {
+    put = msg->try_put<NL80211_ATTR_WIPHY_CHANNEL_TYPE>(
+      static_cast<uint32_t>(nl80211_channel_type::NL80211_CHAN_NO_HT));
+  }
+  if(!put) {
+    return std::unexpected{put.error()};
+  }
+
+  return msg;
 }
 
 
@@ -185,71 +1185,40 @@ void NetlinkGeneric::send_msg(nlmsg_t const& msg,
  *  + NL80211_ATTR_IFNAME
  *  + NL80211_ATTR_IFINDEX
  *  + NL80211_ATTR_WDEV
- *  - NL80211_ATTR_MAC
- *  - NL80211_ATTR_SSID
+ *  + NL80211_ATTR_MAC
+ *  + NL80211_ATTR_SSID
  *  + NL80211_ATTR_IFTYPE: managed, monitor, ...
  *  + NL80211_ATTR_WIPHY: dispositivo fisico
  *  + NL80211_ATTR_WIPHY_FREQ
  *  + NL80211_ATTR_CHANNEL_WIDTH
  *  - NL80211_ATTR_CENTER_FREQ1
  * 
- * See `iw` source code, file `interface.c`, line 285.
+ * See `iw` source code, file `interface.c`, line 285. The parser is generated
+ * from `dev_info_map`.
  *
  * This function is invoked a single time for each existing interface, also for 
  * "Unnamed/non-netdev interface".
  */
 int NetlinkGeneric::get_interface_handler(struct nl_msg* msg, void* arg) noexcept
 {
-  dev_info_t dev_info;
-
-  auto* resultPtr = reinterpret_cast<std::map<uint32_t,dev_info_t>*>(arg);
+  auto* dump = reinterpret_cast<interface_dump_t*>(arg);
 
-  auto gnlh = reinterpret_cast<struct genlmsghdr*>(nlmsg_data(nlmsg_hdr(msg)));
-  struct nlattr* tb_msg[NL80211_ATTR_MAX + 1];
-  uint32_t ifindex = 0;
+  // `NL_STOP` would also skip the `NLMSG_DONE` of the datagram: the request
+  // reads its reply to the end, then reports the error
+  try {
+    dev_info_t dev_info;
+    dev_info_map::parse_genl(msg, dev_info);
 
-  nla_parse(
-    tb_msg, 
-    NL80211_ATTR_MAX, 
-    genlmsg_attrdata(gnlh, 0), 
-    genlmsg_attrlen(gnlh, 0), 
-    nullptr );
+    uint32_t const ifindex = dev_info.if_index.get();
 
-  if(tb_msg[NL80211_ATTR_IFNAME]) {
-    dev_info.if_name = 
-      std::string(nla_get_string(tb_msg[NL80211_ATTR_IFNAME]));
-  }
-  if(tb_msg[NL80211_ATTR_IFINDEX]) {
-    dev_info.if_index.get() = 
-      ifindex = nla_get_u32(tb_msg[NL80211_ATTR_IFINDEX]);
-  }
-  if(tb_msg[NL80211_ATTR_WDEV]) {
-    dev_info.wdev = nla_get_u64(tb_msg[NL80211_ATTR_WDEV]);
-  }
-  // if(tb_msg[NL80211_ATTR_MAC]) { }
-  // if(tb_msg[NL80211_ATTR_SSID]) { }
-  if(tb_msg[NL80211_ATTR_IFTYPE]) {
-    dev_info.type = 
-      static_cast<if_type_e>(nla_get_u32(tb_msg[NL80211_ATTR_IFTYPE]));
-  }
-  if(tb_msg[NL80211_ATTR_WIPHY]) {
-    dev_info.wiphy_index.get() = nla_get_u32(tb_msg[NL80211_ATTR_WIPHY]);
-  }
-  if(tb_msg[NL80211_ATTR_WIPHY_FREQ]) 
-  {
-    dev_info.wiphy_freq = 
-      frequency_t{nla_get_u32(tb_msg[NL80211_ATTR_WIPHY_FREQ])};
-
-    if(tb_msg[NL80211_ATTR_CHANNEL_WIDTH]) {
-      dev_info.channel_width = 
-        nla_get_u32(tb_msg[NL80211_ATTR_CHANNEL_WIDTH]);
+    // for now, we insert the device info inside the result map only if it is 
+    // not a "Unnamed/non-netdev interface"
+    if(ifindex) {
+      dump->result.insert({ifindex, std::move(dev_info)});
     }
   }
-
-  // for now, we insert the device info inside `resultPtr` map only if it is not
-  // a "Unnamed/non-netdev interface"
-  if(ifindex) {
-    resultPtr->insert({ifindex, std::move(dev_info)});
+  catch(std::bad_alloc const&) {
+    dump->err = ENOMEM;
   }
 
   return NL_SKIP;
@@ -258,25 +1227,14 @@ int NetlinkGeneric::get_interface_handler(struct nl_msg* msg, void* arg) noexcep
 
 int NetlinkGeneric::get_feature_handler(struct nl_msg *msg, void *arg) noexcept
 {
-  bool* nl80211_has_split_wiphy = reinterpret_cast<bool*>(arg);
+  auto* features = reinterpret_cast<uint32_t*>(arg);
 
-  struct nlattr* tb_msg[NL80211_ATTR_MAX + 1];
-	auto gnlh = reinterpret_cast<struct genlmsghdr*>(nlmsg_data(nlmsg_hdr(msg)));
+  auto const tb_msg = 
+    nlattr_index_t<NL80211_ATTR_PROTOCOL_FEATURES>::of_genl(msg);
 
-  nla_parse(
-    tb_msg, NL80211_ATTR_MAX, 
-    genlmsg_attrdata(gnlh, 0),
-		genlmsg_attrlen(gnlh, 0), 
-    nullptr );
-
-  if(tb_msg[NL80211_ATTR_PROTOCOL_FEATURES]) 
-  {
-		uint32_t feat = nla_get_u32(tb_msg[NL80211_ATTR_PROTOCOL_FEATURES]);
-
-		if(feat & NL80211_PROTOCOL_FEATURE_SPLIT_WIPHY_DUMP) {
-			*nl80211_has_split_wiphy = true;
-		}
-	}
+  if(auto* attr = tb_msg.get<NL80211_ATTR_PROTOCOL_FEATURES>()) {
+    *features = nla_get_u32(attr);
+  }
 
   return NL_SKIP;
 }
@@ -284,122 +1242,95 @@ int NetlinkGeneric::get_feature_handler(struct nl_msg *msg, void *arg) noexcept
 
 int NetlinkGeneric::get_phy_handler(struct nl_msg* msg, void* arg) noexcept
 {
-  struct nlattr* tb_msg[NL80211_ATTR_MAX + 1];
-	auto gnlh = reinterpret_cast<struct genlmsghdr*>(nlmsg_data(nlmsg_hdr(msg)));
-  struct nlattr* tb_band[NL80211_BAND_ATTR_MAX + 1];
-	struct nlattr* tb_freq[NL80211_FREQUENCY_ATTR_MAX + 1];
-
-  static struct nla_policy freq_policy[NL80211_FREQUENCY_ATTR_MAX + 1]{};
-  freq_policy[NL80211_FREQUENCY_ATTR_FREQ] = { .type = NLA_U32 };
-  freq_policy[NL80211_FREQUENCY_ATTR_DISABLED] = { .type = NLA_FLAG };
-  freq_policy[NL80211_FREQUENCY_ATTR_PASSIVE_SCAN] = { .type = NLA_FLAG };
-  freq_policy[NL80211_FREQUENCY_ATTR_NO_IBSS] = { .type = NLA_FLAG };
-  freq_policy[NL80211_FREQUENCY_ATTR_RADAR] = { .type = NLA_FLAG };
-  freq_policy[NL80211_FREQUENCY_ATTR_MAX_TX_POWER] = { .type = NLA_U32 };
-
-  static int last_band = -1;
-  static uint32_t phy_id = -1;
-  static bool band_had_freq = false;
-
-  // Get the return value pointer
-  auto resultPtr = reinterpret_cast<std::map<uint32_t,dev_capability_t>*>(arg);
-
-  nla_parse(
-    tb_msg, 
-    NL80211_ATTR_MAX, 
-    genlmsg_attrdata(gnlh, 0),
-    genlmsg_attrlen(gnlh, 0), 
-    nullptr );
-
-  if(tb_msg[NL80211_ATTR_WIPHY])
-  {
-    if(nla_get_u32(tb_msg[NL80211_ATTR_WIPHY]) != phy_id) {
-      last_band = -1;
+  auto* dump = reinterpret_cast<phy_dump_t*>(arg);
+
+  auto* gnlh = reinterpret_cast<struct genlmsghdr*>(nlmsg_data(nlmsg_hdr(msg)));
+  auto* head = genlmsg_attrdata(gnlh, 0);
+  int const len = genlmsg_attrlen(gnlh, 0);
+
+  // the kernel puts `NL80211_ATTR_WIPHY` first, so this stops immediately
+  // as `get_interface_handler()`, the error is reported once the reply is read
+  try {
+    if(auto* attr = nla_find(head, len, NL80211_ATTR_WIPHY))
+    {
+      uint32_t const phy_id = nla_get_u32(attr);
+
+      auto [it, inserted] = dump->result.try_emplace(phy_id);
+      if(inserted) {
+        it->second.wiphy_index = wiphy_index_t{phy_id};
+      }
+      dump->current = &it->second;
     }
-    
-    phy_id = nla_get_u32(tb_msg[NL80211_ATTR_WIPHY]);
 
-    if(not resultPtr->contains(phy_id)) {
-      resultPtr->insert({phy_id, dev_capability_t{wiphy_index_t{phy_id}}});
-    } 
-  }
+    if(!dump->current) {
+      return NL_SKIP; // no phy yet: nothing to attach the attributes to
+    }
 
-  if(tb_msg[NL80211_ATTR_WIPHY_NAME]) {
-    resultPtr->at(phy_id).wiphy_name = 
-      nla_get_string(tb_msg[NL80211_ATTR_WIPHY_NAME]);
+    dev_capability_map::parse(head, len, *dump->current);
+  }
+  catch(std::bad_alloc const&) {
+    dump->err = ENOMEM;
   }
 
-  if(tb_msg[NL80211_ATTR_SUPPORTED_IFTYPES]) 
-  {
-    struct nlattr* nl_mode;
-    int rem_mode;
-    nla_for_each_nested(
-      nl_mode, 
-      tb_msg[NL80211_ATTR_SUPPORTED_IFTYPES], 
-      rem_mode) 
-    {
-      resultPtr->at(phy_id).iftypes.emplace_back(
-        static_cast<if_type_e>(nla_type(nl_mode)));
+  return NL_SKIP;
+}
+
+
+int NetlinkGeneric::stream_interface_handler(nlmsg_view_t msg, void* arg) noexcept
+{
+  auto* batch = reinterpret_cast<interface_stream_t*>(arg);
+
+  try {
+    dev_info_t dev_info;
+    dev_info_map::parse_genl(msg, dev_info);
+
+    // as `get_interface_handler()`, skip "Unnamed/non-netdev interfaces"
+    if(dev_info.if_index.get()) {
+      batch->ready.push_back(std::move(dev_info));
     }
   }
+  catch(std::bad_alloc const&) {
+    batch->err = ENOMEM;  // the visit fails after this datagram
+    return NL_STOP;
+  }
 
-  if(tb_msg[NL80211_ATTR_WIPHY_BANDS])
-  {
-    struct nlattr* nl_band;
-    int rem_band;
+  return NL_SKIP;
+}
 
-    nla_for_each_nested(nl_band, tb_msg[NL80211_ATTR_WIPHY_BANDS], rem_band) 
-    {
-      if(last_band != nl_band->nla_type) {
-        band_had_freq = false;
-      }
-      last_band = nl_band->nla_type;
 
-      nla_parse(
-        tb_band, 
-        NL80211_BAND_ATTR_MAX, 
-        reinterpret_cast<struct nlattr*>(nla_data(nl_band)), 
-        nla_len(nl_band),
-        nullptr );
+int NetlinkGeneric::stream_phy_handler(nlmsg_view_t msg, void* arg) noexcept
+{
+  auto* stream = reinterpret_cast<phy_stream_t*>(arg);
 
-      if(tb_band[NL80211_BAND_ATTR_FREQS]) 
-      {
-        if(!band_had_freq) {
-          band_had_freq = true;
-        }
+  try {
+    // the kernel puts `NL80211_ATTR_WIPHY` first, so this stops immediately
+    for(auto const attr: msg.genl_attrs())
+    {
+      if(attr.type() != NL80211_ATTR_WIPHY) {
+        continue;
+      }
 
-        struct nlattr *nl_freq;
-        int rem_freq;
-        nla_for_each_nested(nl_freq, tb_band[NL80211_BAND_ATTR_FREQS], rem_freq)
-        {
-          nla_parse(
-            tb_freq, 
-            NL80211_FREQUENCY_ATTR_MAX, 
-            reinterpret_cast<struct nlattr*>(nla_data(nl_freq)),
-            nla_len(nl_freq), 
-            freq_policy );
-            
-					if(!tb_freq[NL80211_FREQUENCY_ATTR_FREQ]) {
-            continue;
-          }
+      auto const phy_id = attr.get<uint32_t>();
 
-          resultPtr->at(phy_id).freqs.emplace_back(
-            nla_get_u32(tb_freq[NL80211_FREQUENCY_ATTR_FREQ]) );
-        }
+      // a split dump sends the messages of a phy in a row: a new id 
+      // completes the previous phy
+      if(stream->current && stream->current->wiphy_index.get() != phy_id) {
+        stream->ready.push_back(*std::exchange(stream->current, {}));
+      }
+      if(!stream->current) {
+        stream->current.emplace(wiphy_index_t{phy_id});
       }
+      break;
     }
-  }
 
-  if(tb_msg[NL80211_ATTR_SUPPORTED_COMMANDS]) 
-  {
-    struct nlattr *nl_cmd;
-    int rem_cmd;
-    nla_for_each_nested(nl_cmd, tb_msg[NL80211_ATTR_SUPPORTED_COMMANDS], rem_cmd)
-    {
-      resultPtr->at(phy_id).cmds.push_back(
-        static_cast<nl80211_command_e>(nla_get_u32(nl_cmd)) );
+    if(stream->current) {
+      dev_capability_map::parse_genl(msg, *stream->current);
     }
   }
+  catch(std::bad_alloc const&) {
+    stream->err = ENOMEM;  // the visit fails after this datagram
+    return NL_STOP;
+  }
 
   return NL_SKIP;
-}
\ No newline at end of file
+}
@@ -2,6 +2,7 @@
 
 
 #include <stdexcept>
+#include <system_error>
 
 #include <netlink/route/link.h>
 
@@ -19,6 +20,12 @@ NetlinkRoute::NetlinkRoute()
 
 
 rtnl_link_t NetlinkRoute::get_kernel(if_index_t ifindex)
+{
+  return unwrap(this->try_get_kernel(ifindex));
+}
+
+
+expected<rtnl_link_t> NetlinkRoute::try_get_kernel(if_index_t ifindex) noexcept
 {
   struct rtnl_link* linkPtr;  // out argument for `rtnl_link_get_kernel()`
     
@@ -26,7 +33,8 @@ rtnl_link_t NetlinkRoute::get_kernel(if_index_t ifindex)
     = rtnl_link_get_kernel(socket_.get_pointer(), ifindex.get(), {}, &linkPtr);
 
   if(err < 0) {
-    throw std::runtime_error{nl_geterror(err)};
+    return std::unexpected{
+      error::from_nlerr(err, RTM_GETLINK, "rtnl_link_get_kernel")};
   }
 
   return rtnl_link_t{linkPtr};
@@ -34,6 +42,13 @@ rtnl_link_t NetlinkRoute::get_kernel(if_index_t ifindex)
 
 
 rtnl_link_t NetlinkRoute::get_kernel(std::string const& ifname)
+{
+  return unwrap(this->try_get_kernel(ifname));
+}
+
+
+expected<rtnl_link_t> 
+NetlinkRoute::try_get_kernel(std::string const& ifname) noexcept
 {
   struct rtnl_link* linkPtr;  // out argument for `rtnl_link_get_kernel()`
   
@@ -41,7 +56,8 @@ rtnl_link_t NetlinkRoute::get_kernel(std::string const& ifname)
     = rtnl_link_get_kernel(socket_.get_pointer(), {}, ifname.c_str(), &linkPtr);
 
   if(err < 0) {
-    throw std::runtime_error{nl_geterror(err)};
+    return std::unexpected{
+      error::from_nlerr(err, RTM_GETLINK, "rtnl_link_get_kernel")};
   }
 
   return rtnl_link_t{linkPtr};
@@ -49,9 +65,89 @@ rtnl_link_t NetlinkRoute::get_kernel(std::string const& ifname)
 
 
 void NetlinkRoute::link_change(rtnl_link_t& link, rtnl_link_t& change, int flags)
+{
+  unwrap(this->try_link_change(link, change, flags));
+}
+
+
+expected<> NetlinkRoute::try_link_change(rtnl_link_t& link, 
+                                         rtnl_link_t& change, 
+                                         int flags) noexcept
 {
   auto err = rtnl_link_change(socket_.get_pointer(), link.get_pointer(), change.get_pointer(), flags);
   if(err < 0) {
-    throw std::runtime_error{nl_geterror(err)};
+    return std::unexpected{
+      error::from_nlerr(err, RTM_NEWLINK, "rtnl_link_change")};
+  }
+
+  return {};
+}
+
+
+expected<uint32_t> NetlinkRoute::post_link_change(rtnl_link_t& link, 
+                                                  rtnl_link_t& change, 
+                                                  int flags) noexcept
+{
+  auto msg = NetlinkRoute::make_link_change(link, change, flags);
+  if(!msg) {
+    return std::unexpected{msg.error()};
+  }
+
+  return socket_.try_send_nowait(*msg);
+}
+
+
+std::vector<nlack_t> NetlinkRoute::collect_errors()
+{
+  socket_.drain();
+
+  return socket_.take_errors();
+}
+
+
+void NetlinkRoute::attach(nlreactor_t& reactor)
+{
+  async_socket_.connect(netlink_protocol_e::route);
+  reactor.add(async_socket_);
+  reactor_ = &reactor;
+}
+
+
+task<> NetlinkRoute::async_link_change(rtnl_link_t& link, rtnl_link_t& change, 
+                                       int flags)
+{
+  return this->async_request(
+    unwrap(NetlinkRoute::make_link_change(link, change, flags)));
+}
+
+
+expected<nlmsg_t> NetlinkRoute::make_link_change(rtnl_link_t& link, 
+                                                 rtnl_link_t& change, 
+                                                 int flags) noexcept
+{
+  struct nl_msg* msgPtr;  // out argument for `rtnl_link_build_change_request()`
+
+  int err = rtnl_link_build_change_request(
+    link.get_pointer(), change.get_pointer(), flags, &msgPtr);
+
+  if(err < 0) {
+    return std::unexpected{error::from_nlerr(
+      err, RTM_NEWLINK, "rtnl_link_build_change_request")};
+  }
+
+  return nlmsg_t{msgPtr};
+}
+
+
+task<> NetlinkRoute::async_request(nlmsg_t msg)
+{
+  if(!reactor_) {
+    throw std::logic_error{"NetlinkRoute is not attached to a reactor"};
+  }
+
+  int const err = co_await reactor_->async_send(async_socket_, std::move(msg));
+
+  if(err < 0) {
+    throw_error(error::from_errno(err, RTM_NEWLINK, "async_link_change"));
   }
 }
\ No newline at end of file
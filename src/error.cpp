@@ -0,0 +1,104 @@
+#include "error.hpp"
+
+
+#include <netlink/errno.h>
+
+#include <cerrno>
+#include <format>
+
+
+using namespace nlpp;
+
+
+namespace {
+
+/// @brief Category of the libnl `NLE_*` error codes.
+class nl_category_t : public std::error_category
+{
+public:
+
+  char const* name() const noexcept override { return "libnl"; }
+
+  std::string message(int code) const override { return nl_geterror(code); }
+
+  /// @brief Map a code to the errno libnl derives it from, `EIO` if none.
+  /// @details The reverse of `nl_syserr2nlerr()`, so that libnl errors
+  ///          compare equal to `std::errc` values.
+  std::error_condition default_error_condition(int code) const noexcept override
+  {
+    return {errno_of(code), std::generic_category()};
+  }
+
+private:
+
+  static int errno_of(int code) noexcept
+  {
+    switch(code)
+    {
+      case NLE_INTR:            return EINTR;
+      case NLE_BAD_SOCK:        return EBADF;
+      case NLE_AGAIN:           return EAGAIN;
+      case NLE_NOMEM:           return ENOMEM;
+      case NLE_EXIST:           return EEXIST;
+      case NLE_INVAL:           return EINVAL;
+      case NLE_RANGE:           return ERANGE;
+      case NLE_MSGSIZE:         return EMSGSIZE;
+      case NLE_OPNOTSUPP:       return EOPNOTSUPP;
+      case NLE_AF_NOSUPPORT:    return EAFNOSUPPORT;
+      case NLE_OBJ_NOTFOUND:    return ENOENT;
+      case NLE_MSG_OVERFLOW:    return EOVERFLOW;
+      case NLE_MSG_TRUNC:       return EMSGSIZE;
+      case NLE_NOADDR:          return EADDRNOTAVAIL;
+      case NLE_MSG_TOOSHORT:    return EBADMSG;
+      case NLE_BUSY:            return EBUSY;
+      case NLE_PROTO_MISMATCH:  return EPROTONOSUPPORT;
+      case NLE_NOACCESS:        return EACCES;
+      case NLE_PERM:            return EPERM;
+      case NLE_PARSE_ERR:       return EBADMSG;
+      case NLE_NODEV:           return ENODEV;
+      case NLE_DUMP_INTR:       return EINTR;
+      default:                  return EIO;
+    }
+  }
+};
+
+}
+
+
+std::error_category const& nlpp::nl_category() noexcept
+{
+  static nl_category_t const category;
+  return category;
+}
+
+
+namespace {
+
+/// @brief Describe the failed operation and its command, if any.
+std::string context(error const& err)
+{
+  return err.cmd ? std::format("{} (cmd {})", err.what, err.cmd) : err.what;
+}
+
+}
+
+
+int error::to_errno() const noexcept
+{
+  auto const condition = code.default_error_condition();
+
+  return condition.category() == std::generic_category()
+    ? condition.value() : EIO;
+}
+
+
+std::string error::message() const
+{
+  return std::format("{}: {}", context(*this), code.message());
+}
+
+
+void nlpp::throw_error(error const& err)
+{
+  throw std::system_error{err.code, context(err)};
+}
@@ -0,0 +1,305 @@
+#include "genl_family_cache_t.hpp"
+
+
+#include "nlmsg_t.hpp"
+
+#include <netlink/genl/ctrl.h>
+#include <netlink/genl/genl.h>
+#include <linux/genetlink.h>
+
+#include <chrono>
+#include <new>
+#include <system_error>
+#include <utility>
+
+
+using namespace nlpp;
+
+
+genl_family_cache_t& genl_family_cache_t::instance()
+{
+  static genl_family_cache_t cache;
+  return cache;
+}
+
+
+genl_family_t genl_family_cache_t::resolve(nlsocket_t& socket, std::string_view name)
+{
+  return unwrap(this->try_resolve(socket, name));
+}
+
+
+expected<genl_family_t>
+genl_family_cache_t::try_resolve(nlsocket_t& socket, std::string_view name)
+{
+  bool watching{};
+  uint64_t generation{};
+
+  {
+    std::lock_guard lock{mutex_};
+
+    watching = this->watch();
+    if(watching)
+    {
+      this->process_events();
+
+      if(auto found = families_.find(name); found != std::end(families_)) {
+        return found->second;
+      }
+
+      generation = this->generation(name);
+    }
+  }
+
+  // miss: a round trip on the caller socket, without holding the lock
+  auto msg = nlmsg_t::try_create(GENL_ID_CTRL, uint8_t{CTRL_CMD_GETFAMILY});
+  if(!msg) {
+    return std::unexpected{msg.error()};
+  }
+
+  if(auto put = msg->try_put_string(CTRL_ATTR_FAMILY_NAME, name); !put) {
+    return std::unexpected{put.error()};
+  }
+
+  if(auto sent = socket.try_send_auto(*msg); !sent) {
+    return std::unexpected{sent.error()};
+  }
+
+  family_reply_t reply;
+
+  if(auto received = socket.try_recv_raw(&genl_family_cache_t::family_handler,
+                                         &reply); !received) {
+    return std::unexpected{received.error()};
+  }
+
+  if(reply.err) {
+    return std::unexpected{
+      error::from_errno(reply.err, CTRL_CMD_GETFAMILY, "genl_ctrl_resolve")};
+  }
+
+  auto& family = reply.family;
+
+  if(family.id == 0) {
+    return std::unexpected{
+      error::from_errno(ENOENT, CTRL_CMD_GETFAMILY, "genl_ctrl_resolve")};
+  }
+
+  std::lock_guard lock{mutex_};
+
+  ++misses_;
+
+  if(watching)
+  {
+    this->process_events();
+
+    // the reply may predate a change applied by another thread meanwhile
+    if(this->generation(name) == generation) {
+      families_.insert_or_assign(family.name, family);
+    }
+  }
+
+  return std::move(family);
+}
+
+
+void genl_family_cache_t::invalidate(std::string_view name)
+{
+  std::lock_guard lock{mutex_};
+
+  if(auto found = families_.find(name); found != std::end(families_)) {
+    families_.erase(found);
+  }
+  this->bump(name);
+}
+
+
+void genl_family_cache_t::clear()
+{
+  std::lock_guard lock{mutex_};
+
+  families_.clear();
+  ++epoch_;
+}
+
+
+std::size_t genl_family_cache_t::misses() const noexcept
+{
+  std::lock_guard lock{mutex_};
+  return misses_;
+}
+
+
+bool genl_family_cache_t::watch() noexcept
+{
+  if(watching_) {
+    return *watching_;
+  }
+
+  watching_ = false;
+
+  if(!notify_.try_connect(netlink_protocol_e::generic)) {
+    return false;
+  }
+
+  // a round trip, once per process
+  int const group = genl_ctrl_resolve_grp(notify_.get_pointer(), "nlctrl", "notify");
+  if(group < 0) {
+    return false;
+  }
+
+  if(!notify_.try_add_membership(static_cast<uint32_t>(group))
+    || !notify_.try_set_nonblocking()) {
+    return false;
+  }
+
+  watching_ = true;
+
+  return true;
+}
+
+
+void genl_family_cache_t::process_events() noexcept
+{
+  for(;;)
+  {
+    auto received = notify_.try_recv_raw_next(
+      &genl_family_cache_t::event_handler, this, std::chrono::milliseconds{});
+
+    if(!received)
+    {
+      // notifications were lost when the socket overran: trust nothing
+      if(received.error().code != std::errc::timed_out) 
+      {
+        families_.clear();
+        ++epoch_;
+      }
+      return;
+    }
+  }
+}
+
+
+uint64_t genl_family_cache_t::generation(std::string_view name) const noexcept
+{
+  auto found = generations_.find(name);
+
+  // both only grow: the sum changes when either does
+  return epoch_ + (found != std::end(generations_) ? found->second : 0);
+}
+
+
+void genl_family_cache_t::bump(std::string_view name) noexcept
+{
+  if(auto found = generations_.find(name); found != std::end(generations_))
+  {
+    ++found->second;
+    return;
+  }
+
+  try {
+    generations_.emplace(name, 1);
+  }
+  catch(std::bad_alloc const&) {
+    ++epoch_;   // the change is counted for every family instead
+  }
+}
+
+
+int genl_family_cache_t::family_handler(nlmsg_view_t msg, void* arg) noexcept
+{
+  auto* reply = reinterpret_cast<family_reply_t*>(arg);
+  auto* family = &reply->family;
+
+  try {
+    for(auto const attr: msg.genl_attrs())
+    {
+      switch(attr.type())
+      {
+        case CTRL_ATTR_FAMILY_ID:
+          family->id = attr.get<uint16_t>();
+          break;
+
+        case CTRL_ATTR_FAMILY_NAME:
+          family->name = attr.str();
+          break;
+
+        case CTRL_ATTR_VERSION:
+          family->version = attr.get<uint32_t>();
+          break;
+
+        case CTRL_ATTR_HDRSIZE:
+          family->hdrsize = attr.get<uint32_t>();
+          break;
+
+        case CTRL_ATTR_MAXATTR:
+          family->maxattr = attr.get<uint32_t>();
+          break;
+
+        case CTRL_ATTR_MCAST_GROUPS:
+          for(auto const group: attr.nested())
+          {
+            std::string_view name;
+            uint32_t id{};
+
+            for(auto const field: group.nested())
+            {
+              if(field.type() == CTRL_ATTR_MCAST_GRP_NAME) {
+                name = field.str();
+              }
+              else if(field.type() == CTRL_ATTR_MCAST_GRP_ID) {
+                id = field.get<uint32_t>();
+              }
+            }
+
+            if(!name.empty()) {
+              family->groups.insert_or_assign(std::string{name}, id);
+            }
+          }
+          break;
+
+        default:
+          break;
+      }
+    }
+  }
+  catch(std::bad_alloc const&) {
+    reply->err = ENOMEM;
+    return NL_STOP;
+  }
+
+  return NL_SKIP;
+}
+
+
+int genl_family_cache_t::event_handler(nlmsg_view_t msg, void* arg) noexcept
+{
+  auto* self = reinterpret_cast<genl_family_cache_t*>(arg);
+
+  switch(msg.genl()->cmd)
+  {
+    case CTRL_CMD_NEWFAMILY:    // registered again, maybe with another id
+    case CTRL_CMD_DELFAMILY:
+    case CTRL_CMD_NEWMCAST_GRP:
+    case CTRL_CMD_DELMCAST_GRP:
+      break;
+
+    default:
+      return NL_SKIP;
+  }
+
+  for(auto const attr: msg.genl_attrs())
+  {
+    if(attr.type() != CTRL_ATTR_FAMILY_NAME) {
+      continue;
+    }
+
+    if(auto found = self->families_.find(attr.str());
+       found != std::end(self->families_)) {
+      self->families_.erase(found);
+    }
+    self->bump(attr.str());
+    break;
+  }
+
+  return NL_SKIP;
+}
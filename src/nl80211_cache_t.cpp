@@ -0,0 +1,390 @@
+#include "nl80211_cache_t.hpp"
+
+
+#include "genl_family_cache_t.hpp"
+
+#include <linux/nl80211.h>
+
+#include <algorithm>
+#include <new>
+#include <system_error>
+
+
+using namespace nlpp;
+
+
+dev_info_t const* nl80211_state_t::interface(if_index_t if_index) const noexcept
+{
+  auto found = interfaces.find(if_index.get());
+
+  return found != std::end(interfaces) ? &found->second : nullptr;
+}
+
+
+dev_info_t const* nl80211_state_t::interface(std::string_view if_name) const noexcept
+{
+  // a handful of interfaces: a scan beats a second index
+  auto found = std::ranges::find_if(interfaces, [if_name](auto const& item) {
+    return item.second.if_name == if_name;
+  });
+
+  return found != std::end(interfaces) ? &found->second : nullptr;
+}
+
+
+dev_capability_t const* nl80211_state_t::phy(wiphy_index_t phy_index) const noexcept
+{
+  auto found = phys.find(phy_index.get());
+
+  return found != std::end(phys) ? found->second.get() : nullptr;
+}
+
+
+nl80211_cache_t::nl80211_cache_t()
+: events_{netlink_protocol_e::generic}
+{
+  auto const family =
+    genl_family_cache_t::instance().resolve(genl_.socket(), "nl80211");
+
+  // subscribe before the dumps: the events of the dump window are applied
+  // on top of them, in order, so no change falls in between
+  for(auto const* name: {"config", "mlme"})
+  {
+    if(auto group = family.group(name)) {
+      events_.add_membership(*group);
+    }
+  }
+
+  events_.set_nonblocking();
+  events_.set_autotune(true);
+
+  this->refresh();
+}
+
+
+std::size_t nl80211_cache_t::process_events(std::chrono::milliseconds timeout)
+{
+  return unwrap(this->try_process_events(timeout));
+}
+
+
+expected<std::size_t>
+nl80211_cache_t::try_process_events(std::chrono::milliseconds timeout) noexcept
+{
+  applied_ = 0;
+
+  for(auto wait = timeout;; wait = {})
+  {
+    auto received = events_.try_recv_raw_next(
+      &nl80211_cache_t::event_handler, this, wait);
+
+    if(received) {
+      continue;
+    }
+
+    if(received.error().code == std::errc::timed_out) {
+      break;
+    }
+
+    // the socket overran: some notifications are lost, drain the others
+    if(received.error().code == std::errc::no_buffer_space) {
+      resync_ = true;
+      continue;
+    }
+
+    return std::unexpected{received.error()};
+  }
+
+  if(resync_)
+  {
+    if(auto refreshed = this->try_refresh(); !refreshed) {
+      return std::unexpected{refreshed.error()};
+    }
+    return applied_;
+  }
+
+  if(auto fetched = this->try_fetch_stale(); !fetched) {
+    return std::unexpected{fetched.error()};
+  }
+
+  this->publish();
+
+  return applied_;
+}
+
+
+void nl80211_cache_t::refresh()
+{
+  unwrap(this->try_refresh());
+}
+
+
+expected<> nl80211_cache_t::try_refresh() noexcept
+{
+  auto interfaces = genl_.try_get_list_interfaces();
+  if(!interfaces) {
+    return std::unexpected{interfaces.error()};
+  }
+
+  auto phys = genl_.try_get_list_phys();
+  if(!phys) {
+    return std::unexpected{phys.error()};
+  }
+
+  try
+  {
+    auto state = std::make_shared<nl80211_state_t>();
+    state->interfaces = std::move(*interfaces);
+
+    for(auto& [phy_id, phy]: *phys) {
+      state->phys.emplace(phy_id,
+        std::make_shared<dev_capability_t const>(std::move(phy)));
+    }
+
+    working_ = std::move(state);
+  }
+  catch(std::bad_alloc const&) {
+    return std::unexpected{error::from_errno(ENOMEM, {}, "refresh")};
+  }
+
+  // the dumps cover every pending fetch
+  stale_interfaces_.clear();
+  stale_phys_.clear();
+  resync_ = false;
+
+  this->publish();
+
+  return {};
+}
+
+
+void nl80211_cache_t::refresh(if_index_t if_index)
+{
+  unwrap(this->try_refresh(if_index));
+}
+
+
+expected<> nl80211_cache_t::try_refresh(if_index_t if_index) noexcept
+{
+  if(auto fetched = this->try_fetch_interface(if_index); !fetched) {
+    return fetched;
+  }
+
+  this->publish();
+
+  return {};
+}
+
+
+expected<> nl80211_cache_t::try_fetch_interface(if_index_t if_index) noexcept
+{
+  auto info = genl_.try_get_interface(if_index);
+
+  if(!info && info.error().code != std::errc::no_such_device) {
+    return std::unexpected{info.error()};
+  }
+
+  try
+  {
+    auto& state = this->edit();
+
+    if(info) {
+      state.interfaces.insert_or_assign(if_index.get(), std::move(*info));
+    }
+    else {
+      state.interfaces.erase(if_index.get());
+    }
+  }
+  catch(std::bad_alloc const&) {
+    return std::unexpected{error::from_errno(ENOMEM, {}, "fetch")};
+  }
+
+  return {};
+}
+
+
+nl80211_state_t& nl80211_cache_t::edit()
+{
+  if(!working_)
+  {
+    auto const current = this->snapshot();
+    working_ = current ? std::make_shared<nl80211_state_t>(*current)
+                       : std::make_shared<nl80211_state_t>();
+  }
+
+  return *working_;
+}
+
+
+expected<> nl80211_cache_t::try_fetch_stale() noexcept
+{
+  for(auto const phy_id: stale_phys_)
+  {
+    auto phy = genl_.try_get_phy(wiphy_index_t{phy_id});
+
+    // unplugged meanwhile: its `NL80211_CMD_DEL_WIPHY` is pending
+    if(!phy && phy.error().code == std::errc::no_such_device) {
+      continue;
+    }
+    if(!phy) {
+      return std::unexpected{phy.error()};
+    }
+
+    try {
+      this->edit().phys.insert_or_assign(phy_id,
+        std::make_shared<dev_capability_t const>(std::move(*phy)));
+    }
+    catch(std::bad_alloc const&) {
+      return std::unexpected{error::from_errno(ENOMEM, {}, "fetch")};
+    }
+  }
+  stale_phys_.clear();
+
+  for(auto const ifindex: stale_interfaces_)
+  {
+    if(auto fetched = this->try_fetch_interface(if_index_t{ifindex}); !fetched) {
+      return fetched;
+    }
+  }
+  stale_interfaces_.clear();
+
+  return {};
+}
+
+
+void nl80211_cache_t::publish() noexcept
+{
+  if(!working_) {
+    return;
+  }
+
+  auto const current = this->snapshot();
+  working_->generation = current ? current->generation + 1 : 1;
+
+  state_.store(std::move(working_), std::memory_order_release);
+  working_.reset();
+}
+
+
+void nl80211_cache_t::apply(nlmsg_view_t msg)
+{
+  switch(auto const cmd = msg.genl()->cmd; cmd)
+  {
+    case NL80211_CMD_NEW_INTERFACE:
+    case NL80211_CMD_SET_INTERFACE:
+    {
+      // the notification carries the whole interface, as a reply does
+      auto info = NetlinkGeneric::decode_interface(msg);
+      if(auto const ifindex = info.if_index.get()) {
+        this->edit().interfaces.insert_or_assign(ifindex, std::move(info));
+      }
+      break;
+    }
+
+    case NL80211_CMD_DEL_INTERFACE:
+    {
+      auto const info = NetlinkGeneric::decode_interface(msg);
+      this->edit().interfaces.erase(info.if_index.get());
+      break;
+    }
+
+    case NL80211_CMD_CH_SWITCH_NOTIFY:
+    {
+      uint32_t ifindex{};
+      std::optional<frequency_t> freq;
+      std::optional<int> width;
+
+      for(auto const attr: msg.genl_attrs())
+      {
+        switch(attr.type())
+        {
+          case NL80211_ATTR_IFINDEX:
+            ifindex = attr.get<uint32_t>();
+            break;
+          case NL80211_ATTR_WIPHY_FREQ:
+            freq = frequency_t{attr.get<uint32_t>()};
+            break;
+          case NL80211_ATTR_CHANNEL_WIDTH:
+            width = static_cast<int>(attr.get<uint32_t>());
+            break;
+          default:
+            break;
+        }
+      }
+
+      auto& interfaces = this->edit().interfaces;
+      if(auto found = interfaces.find(ifindex); found != std::end(interfaces))
+      {
+        found->second.wiphy_freq = freq;
+        if(width) {
+          found->second.channel_width = *width;
+        }
+      }
+      break;
+    }
+
+    // the association changes the SSID, which is not notified
+    case NL80211_CMD_CONNECT:
+    case NL80211_CMD_ROAM:
+    case NL80211_CMD_DISCONNECT:
+      for(auto const attr: msg.genl_attrs())
+      {
+        if(attr.type() == NL80211_ATTR_IFINDEX) {
+          stale_interfaces_.push_back(attr.get<uint32_t>());
+          break;
+        }
+      }
+      break;
+
+    // the notification of a phy only carries its index and name
+    case NL80211_CMD_NEW_WIPHY:
+    case NL80211_CMD_DEL_WIPHY:
+      for(auto const attr: msg.genl_attrs())
+      {
+        if(attr.type() != NL80211_ATTR_WIPHY) {
+          continue;
+        }
+
+        auto const phy_id = attr.get<uint32_t>();
+
+        if(cmd == NL80211_CMD_NEW_WIPHY) {
+          stale_phys_.push_back(phy_id);
+        }
+        else
+        {
+          auto& state = this->edit();
+          state.phys.erase(phy_id);
+          std::erase_if(state.interfaces, [phy_id](auto const& item) {
+            return item.second.wiphy_index.get() == phy_id;
+          });
+          std::erase(stale_phys_, phy_id);
+        }
+        break;
+      }
+      break;
+
+    default:
+      return;
+  }
+
+  ++applied_;
+}
+
+
+int nl80211_cache_t::event_handler(nlmsg_view_t msg, void* arg) noexcept
+{
+  auto* self = reinterpret_cast<nl80211_cache_t*>(arg);
+
+  if(msg.payload().size() < GENL_HDRLEN) {
+    return NL_SKIP;
+  }
+
+  try {
+    self->apply(msg);
+  }
+  catch(std::bad_alloc const&) {
+    self->resync_ = true; // a change is lost: take the dumps again
+  }
+
+  return NL_SKIP;
+}
@@ -0,0 +1,273 @@
+#include "nlcache_mngr_t.hpp"
+
+
+#include <netlink/object.h>
+#include <linux/rtnetlink.h>
+
+#include <new>
+
+
+using namespace nlpp;
+
+
+nlcache_mngr_t::nlcache_mngr_t(int family)
+: sync_{netlink_protocol_e::route}
+{
+  int err = nl_cache_mngr_alloc(nullptr, NETLINK_ROUTE, 0, &mngrPtr_);
+  if(err < 0) {
+    throw_error(error::from_nlerr(err, RTM_GETLINK, "nl_cache_mngr_alloc"));
+  }
+
+  err = nl_cache_alloc_name("route/link", &cachePtr_);
+  if(err < 0)
+  {
+    nl_cache_mngr_free(mngrPtr_);
+    throw_error(error::from_nlerr(err, RTM_GETLINK, "nl_cache_alloc_name"));
+  }
+
+  nl_cache_set_arg1(cachePtr_, family);
+
+  // subscribe to `RTNLGRP_LINK`, then fill: no change falls in between
+  err = nl_cache_mngr_add_cache(mngrPtr_, cachePtr_,
+    &nlcache_mngr_t::change_handler, this);
+  if(err < 0)
+  {
+    nl_cache_free(cachePtr_);
+    nl_cache_mngr_free(mngrPtr_);
+    throw_error(error::from_nlerr(err, RTM_GETLINK, "nl_cache_mngr_add_cache"));
+  }
+
+  // the fill reports no change
+  this->reindex();
+}
+
+
+nlcache_mngr_t::~nlcache_mngr_t()
+{
+  for(auto& [ifindex, entry]: by_index_) {
+    rtnl_link_put(entry.linkPtr);
+  }
+
+  nl_cache_mngr_free(mngrPtr_);
+}
+
+
+int nlcache_mngr_t::fd() const noexcept
+{
+  return nl_cache_mngr_get_fd(mngrPtr_);
+}
+
+
+std::size_t nlcache_mngr_t::poll(std::chrono::milliseconds timeout)
+{
+  return unwrap(this->try_poll(timeout));
+}
+
+
+expected<std::size_t>
+nlcache_mngr_t::try_poll(std::chrono::milliseconds timeout) noexcept
+{
+  int const applied = nl_cache_mngr_poll(mngrPtr_, static_cast<int>(timeout.count()));
+
+  // the socket overran (`ENOBUFS`): notifications are lost
+  if(applied == -NLE_NOMEM)
+  {
+    if(auto synced = this->try_resync(); !synced) {
+      return std::unexpected{synced.error()};
+    }
+    return 0;
+  }
+
+  if(applied < 0) {
+    return std::unexpected{
+      error::from_nlerr(applied, RTM_GETLINK, "nl_cache_mngr_poll")};
+  }
+
+  if(auto repaired = this->try_repair(); !repaired) {
+    return std::unexpected{repaired.error()};
+  }
+
+  return static_cast<std::size_t>(applied);
+}
+
+
+std::size_t nlcache_mngr_t::data_ready()
+{
+  return unwrap(this->try_data_ready());
+}
+
+
+expected<std::size_t> nlcache_mngr_t::try_data_ready() noexcept
+{
+  int const applied = nl_cache_mngr_data_ready(mngrPtr_);
+
+  if(applied == -NLE_NOMEM)
+  {
+    if(auto synced = this->try_resync(); !synced) {
+      return std::unexpected{synced.error()};
+    }
+    return 0;
+  }
+
+  if(applied < 0) {
+    return std::unexpected{
+      error::from_nlerr(applied, RTM_GETLINK, "nl_cache_mngr_data_ready")};
+  }
+
+  if(auto repaired = this->try_repair(); !repaired) {
+    return std::unexpected{repaired.error()};
+  }
+
+  return static_cast<std::size_t>(applied);
+}
+
+
+void nlcache_mngr_t::resync()
+{
+  unwrap(this->try_resync());
+}
+
+
+expected<> nlcache_mngr_t::try_resync() noexcept
+{
+  int const err = nl_cache_resync(sync_.get_pointer(), cachePtr_,
+    &nlcache_mngr_t::change_handler, this);
+
+  if(err < 0) {
+    return std::unexpected{
+      error::from_nlerr(err, RTM_GETLINK, "nl_cache_resync")};
+  }
+
+  return this->try_repair();
+}
+
+
+std::optional<rtnl_link_t> nlcache_mngr_t::get_link(if_index_t ifindex) const
+{
+  auto found = by_index_.find(ifindex.get());
+  if(found == std::end(by_index_)) {
+    return std::nullopt;
+  }
+
+  // the returned link holds its own reference
+  nl_object_get(OBJ_CAST(found->second.linkPtr));
+  return rtnl_link_t{found->second.linkPtr};
+}
+
+
+std::optional<rtnl_link_t> nlcache_mngr_t::get_link(std::string_view ifname) const
+{
+  auto found = by_name_.find(ifname);
+  if(found == std::end(by_name_)) {
+    return std::nullopt;
+  }
+
+  return this->get_link(if_index_t{found->second});
+}
+
+
+std::string nlcache_mngr_t::i2name(if_index_t ifindex) const
+{
+  auto found = by_index_.find(ifindex.get());
+
+  return found != std::end(by_index_) ? found->second.name : std::string{};
+}
+
+
+std::optional<if_index_t> nlcache_mngr_t::name2i(std::string_view ifname) const
+{
+  auto found = by_name_.find(ifname);
+
+  return found != std::end(by_name_)
+    ? std::make_optional(if_index_t{found->second})
+      : std::nullopt;
+}
+
+
+void nlcache_mngr_t::index(struct rtnl_link* linkPtr, cache_action_e action)
+{
+  auto const ifindex = static_cast<uint32_t>(rtnl_link_get_ifindex(linkPtr));
+  auto found = by_index_.find(ifindex);
+
+  if(found != std::end(by_index_))
+  {
+    // the name may already belong to another link, after a swap
+    if(auto named = by_name_.find(found->second.name);
+       named != std::end(by_name_) && named->second == ifindex) {
+      by_name_.erase(named);
+    }
+
+    rtnl_link_put(found->second.linkPtr);
+    by_index_.erase(found);
+  }
+
+  if(action == cache_action_e::del) {
+    return;
+  }
+
+  char const* name = rtnl_link_get_name(linkPtr);
+
+  entry_t entry{linkPtr, name ? name : ""};
+  by_name_.insert_or_assign(entry.name, ifindex);
+
+  nl_object_get(OBJ_CAST(linkPtr));
+  by_index_.emplace(ifindex, std::move(entry));
+}
+
+
+void nlcache_mngr_t::reindex()
+{
+  for(auto& [ifindex, entry]: by_index_) {
+    rtnl_link_put(entry.linkPtr);
+  }
+  by_index_.clear();
+  by_name_.clear();
+
+  for(auto* obj = nl_cache_get_first(cachePtr_); obj; obj = nl_cache_get_next(obj)) {
+    this->index(reinterpret_cast<struct rtnl_link*>(obj), cache_action_e::add);
+  }
+
+  stale_ = false;
+}
+
+
+expected<> nlcache_mngr_t::try_repair() noexcept
+{
+  if(!stale_) {
+    return {};
+  }
+
+  try {
+    this->reindex();
+  }
+  catch(std::bad_alloc const&) {
+    return std::unexpected{error::from_errno(ENOMEM, RTM_GETLINK, "reindex")};
+  }
+
+  return {};
+}
+
+
+void nlcache_mngr_t::change_handler(struct nl_cache*, struct nl_object* obj,
+                                    int action, void* arg) noexcept
+{
+  auto* self = reinterpret_cast<nlcache_mngr_t*>(arg);
+  auto* linkPtr = reinterpret_cast<struct rtnl_link*>(obj);
+  auto const change = static_cast<cache_action_e>(action);
+
+  try {
+    self->index(linkPtr, change);
+  }
+  catch(std::bad_alloc const&) {
+    self->stale_ = true;  // rebuilt from the cache before returning
+  }
+
+  if(self->handler_)
+  {
+    // the handler holds its own reference
+    nl_object_get(obj);
+    rtnl_link_t link{linkPtr};
+
+    self->handler_(change, link);
+  }
+}
@@ -3,6 +3,7 @@
 
 #include <netlink/errno.h>
 
+#include <stdexcept>
 #include <system_error>
 
 
@@ -19,6 +20,16 @@ nlcb_t::nlcb_t(enum nl_cb_kind kind)
 }
 
 
+nlcb_t::nlcb_t(struct nl_cb* otherPtr)
+{
+  if(!otherPtr) {
+    throw std::logic_error{"invalid struct nl_cb pointer"};
+  }
+
+  cbPtr_ = otherPtr;
+}
+
+
 nlcb_t::nlcb_t(nlcb_t&& other) noexcept
 {
   this->cbPtr_ = std::exchange(other.cbPtr_, nullptr);
@@ -0,0 +1,87 @@
+#include "nlmsg_pool_t.hpp"
+
+
+#include <algorithm>
+#include <cstring>
+
+#include <linux/netlink.h>
+
+
+using namespace nlpp;
+
+
+nlmsg_pool_t::nlmsg_pool_t(std::size_t msg_size, std::size_t capacity)
+: msg_size_{msg_size}, capacity_{capacity}
+{
+  free_.reserve(capacity_); // `release()` must never allocate
+}
+
+
+nlmsg_pool_t::~nlmsg_pool_t()
+{
+  for(auto* msgPtr: free_) {
+    nlmsg_free(msgPtr);
+  }
+}
+
+
+nlmsg_pool_t& nlmsg_pool_t::local() noexcept
+{
+  thread_local nlmsg_pool_t pool;
+  return pool;
+}
+
+
+bool nlmsg_pool_t::prefill(std::size_t count) noexcept
+{
+  while(free_.size() < std::min(count, capacity_)) 
+  {
+    auto* msgPtr = this->allocate();
+    if(!msgPtr) {
+      return false;
+    }
+    free_.push_back(msgPtr);
+  }
+
+  return true;
+}
+
+
+struct nl_msg* nlmsg_pool_t::acquire() noexcept
+{
+  if(free_.empty()) {
+    return this->allocate();
+  }
+
+  auto* msgPtr = free_.back();
+  free_.pop_back();
+
+  return msgPtr;
+}
+
+
+void nlmsg_pool_t::release(struct nl_msg* msgPtr) noexcept
+{
+  if(!msgPtr) {
+    return;
+  }
+
+  if(free_.size() == capacity_) {
+    nlmsg_free(msgPtr);
+    return;
+  }
+
+  // back to the state of `nlmsg_alloc()`: the payload is overwritten by the
+  // next request, since libnl appends after `nlmsg_len`
+  auto* hdr = ::nlmsg_hdr(msgPtr);
+  std::memset(hdr, 0, NLMSG_HDRLEN);
+  hdr->nlmsg_len = NLMSG_HDRLEN;
+
+  free_.push_back(msgPtr);
+}
+
+
+struct nl_msg* nlmsg_pool_t::allocate() const noexcept
+{
+  return msg_size_ ? nlmsg_alloc_size(msg_size_) : nlmsg_alloc();
+}
@@ -4,6 +4,7 @@
 #include <netlink/errno.h>
 #include <netlink/genl/genl.h>
 
+#include <stdexcept>
 #include <system_error>
 
 
@@ -27,9 +28,92 @@ nlmsg_t::nlmsg_t(int family, nl80211_commands cmd, int flags)
 }
 
 
+nlmsg_t::nlmsg_t(nlmsg_pool_t& pool)
+: msgPtr_{pool.acquire()}, pool_{&pool}
+{
+  if(!msgPtr_) {
+    throw std::system_error{ENOMEM, std::system_category(), 
+      "unable to allocate netlink message"};
+  }
+}
+
+
+nlmsg_t::nlmsg_t(nlmsg_pool_t& pool, int family, nl80211_commands cmd, int flags)
+: nlmsg_t(pool)
+{
+  this->put_genl(family, cmd, flags);
+}
+
+
+nlmsg_t::nlmsg_t(struct nl_msg* otherPtr)
+{
+  if(!otherPtr) {
+    throw std::logic_error{"invalid struct nl_msg pointer"};
+  }
+
+  msgPtr_ = otherPtr;
+}
+
+
+expected<nlmsg_t> nlmsg_t::try_create(int family, nl80211_commands cmd, 
+                                      int flags) noexcept
+{
+  auto* msgPtr = nlmsg_alloc();
+  if(!msgPtr) {
+    return std::unexpected{error::from_errno(ENOMEM, cmd, "nlmsg_alloc")};
+  }
+
+  nlmsg_t msg{msgPtr};
+
+  if(auto put = msg.try_put_genl(family, cmd, flags); !put) {
+    return std::unexpected{put.error()};
+  }
+
+  return msg;
+}
+
+
+expected<nlmsg_t> nlmsg_t::try_create(int family, uint8_t cmd, 
+                                      int flags) noexcept
+{
+  auto* msgPtr = nlmsg_alloc();
+  if(!msgPtr) {
+    return std::unexpected{error::from_errno(ENOMEM, cmd, "nlmsg_alloc")};
+  }
+
+  nlmsg_t msg{msgPtr};
+
+  if(auto put = msg.try_put_genl(family, cmd, flags); !put) {
+    return std::unexpected{put.error()};
+  }
+
+  return msg;
+}
+
+
+expected<nlmsg_t> nlmsg_t::try_create(nlmsg_pool_t& pool, int family, 
+                                      nl80211_commands cmd, int flags) noexcept
+{
+  auto* msgPtr = pool.acquire();
+  if(!msgPtr) {
+    return std::unexpected{error::from_errno(ENOMEM, cmd, "nlmsg_alloc")};
+  }
+
+  nlmsg_t msg{msgPtr};
+  msg.pool_ = &pool;
+
+  if(auto put = msg.try_put_genl(family, cmd, flags); !put) {
+    return std::unexpected{put.error()};
+  }
+
+  return msg;
+}
+
+
 nlmsg_t::nlmsg_t(nlmsg_t&& other) noexcept
 {
   this->msgPtr_ = std::exchange(other.msgPtr_, nullptr);
+  this->pool_ = std::exchange(other.pool_, nullptr);
 }
 
 
@@ -44,7 +128,12 @@ nlmsg_t& nlmsg_t::operator=(nlmsg_t&& rhs) noexcept
 
 nlmsg_t::~nlmsg_t()
 {
-  nlmsg_free(this->msgPtr_);
+  if(this->pool_) {
+    this->pool_->release(this->msgPtr_);
+  }
+  else {
+    nlmsg_free(this->msgPtr_);
+  }
 }
 
 
@@ -55,54 +144,232 @@ struct nl_msg* nlmsg_t::get_pointer() const noexcept
 
 
 void nlmsg_t::put_attr(nlattr_t attr)
+{
+  unwrap(this->try_put_attr(std::move(attr)));
+}
+
+
+expected<> nlmsg_t::try_put_attr(nlattr_t attr) noexcept
+{
+  return this->try_put_attr(attr.name, attr.value);
+}
+
+
+void nlmsg_t::put_attr(int type, nlattr_val_t const& value)
+{
+  unwrap(this->try_put_attr(type, value));
+}
+
+
+expected<> nlmsg_t::try_put_attr(int type, nlattr_val_t const& value) noexcept
 {
   int err 
-    = std::visit([msgPtr=this->msgPtr_, name=attr.name](auto value) -> int
+    = std::visit([msgPtr=this->msgPtr_, type](auto const& value) -> int
     {
-      if constexpr(std::is_same_v<decltype(value), uint8_t>) {
-        return nla_put_u8(msgPtr, name, value);
+      using value_t = std::remove_cvref_t<decltype(value)>;
+
+      if constexpr(std::is_same_v<value_t, uint8_t>) {
+        return nla_put_u8(msgPtr, type, value);
+      }
+      else if constexpr(std::is_same_v<value_t, uint16_t>) {
+        return nla_put_u16(msgPtr, type, value);
       }
-      else if constexpr(std::is_same_v<decltype(value), uint16_t>) {
-        return nla_put_u16(msgPtr, name, value);
+      else if constexpr(std::is_same_v<value_t, uint32_t>) {
+        return nla_put_u32(msgPtr, type, value);
       }
-      else if constexpr(std::is_same_v<decltype(value), uint32_t>) {
-        return nla_put_u32(msgPtr, name, value);
+      else if constexpr(std::is_same_v<value_t, uint64_t>) {
+        return nla_put_u64(msgPtr, type, value);
       }
-      else if constexpr(std::is_same_v<decltype(value), uint64_t>) {
-        return nla_put_u64(msgPtr, name, value);
+      else if constexpr(std::is_same_v<value_t, std::string>) {
+        return nla_put_string(msgPtr, type, value.data());
       }
-      else if constexpr(std::is_same_v<decltype(value), std::string>) {
-        return nla_put_string(msgPtr, name, value.data());
+      else if constexpr(std::is_same_v<value_t, std::span<std::byte const>>) {
+        return nla_put(msgPtr, type, static_cast<int>(value.size()), value.data());
       }
-    }, attr.value);
+    }, value);
 
   if(err < 0) {
-    throw std::runtime_error{nl_geterror(err)};
+    return std::unexpected{error::from_nlerr(err, {}, "nla_put")};
+  }
+
+  return {};
+}
+
+
+void nlmsg_t::put_string(int type, std::string_view value)
+{
+  unwrap(this->try_put_string(type, value));
+}
+
+
+void nlmsg_t::put_binary(int type, std::span<std::byte const> value)
+{
+  unwrap(this->try_put_binary(type, value));
+}
+
+
+expected<> nlmsg_t::try_put_binary(int type, 
+                                   std::span<std::byte const> value) noexcept
+{
+  return this->try_put_raw(type, value.data(), value.size());
+}
+
+
+nlnest_t nlmsg_t::nest(int type)
+{
+  return unwrap(this->try_nest(type));
+}
+
+
+expected<nlnest_t> nlmsg_t::try_nest(int type) noexcept
+{
+  auto* attrPtr = nla_nest_start(msgPtr_, type);
+
+  if(!attrPtr) {
+    return std::unexpected{error::from_nlerr(-NLE_NOMEM, {}, "nla_nest_start")};
   }
+
+  return nlnest_t{msgPtr_, attrPtr};
 }
 
 
 void nlmsg_t::put_flag(nl80211_attrs flag)
 {
-  int err = nla_put_flag(msgPtr_, NL80211_ATTR_SPLIT_WIPHY_DUMP);
+  unwrap(this->try_put_flag(flag));
+}
+
+
+expected<> nlmsg_t::try_put_flag(nl80211_attrs flag) noexcept
+{
+  int err = nla_put_flag(msgPtr_, flag);
 
   if(err < 0) {
-    throw std::runtime_error{nl_geterror(err)};
+    return std::unexpected{error::from_nlerr(err, {}, "nla_put_flag")};
   }
+
+  return {};
+}
+
+
+expected<std::byte*> 
+nlmsg_t::try_find_payload(int name, std::size_t len) const noexcept
+{
+  auto* attr = nlmsg_find_attr(::nlmsg_hdr(msgPtr_), GENL_HDRLEN, name);
+
+  if(!attr) {
+    return std::unexpected{error::from_errno(ENOENT, {}, "nlmsg_find_attr")};
+  }
+  if(static_cast<std::size_t>(nla_len(attr)) != len) {
+    return std::unexpected{error::from_errno(EBADMSG, {}, "nlmsg_find_attr")};
+  }
+
+  return static_cast<std::byte*>(nla_data(attr));
+}
+
+
+expected<> nlmsg_t::try_put_raw(int name, void const* data, 
+                                std::size_t len) noexcept
+{
+  int err = nla_put(msgPtr_, name, static_cast<int>(len), data);
+
+  if(err < 0) {
+    return std::unexpected{error::from_nlerr(err, {}, "nla_put")};
+  }
+
+  return {};
+}
+
+
+expected<> nlmsg_t::try_put_string(int type, std::string_view value) noexcept
+{
+  // reserve room for the terminator and copy straight into the message
+  auto* attr = nla_reserve(msgPtr_, type, static_cast<int>(value.size() + 1));
+
+  if(!attr) {
+    return std::unexpected{error::from_nlerr(-NLE_NOMEM, {}, "nla_reserve")};
+  }
+
+  auto* payload = static_cast<char*>(nla_data(attr));
+  value.copy(payload, value.size());
+  payload[value.size()] = '\0';
+
+  return {};
 }
 
 
 // TODO: missing remaining parameters.
 void nlmsg_t::put_genl(int family, nl80211_commands cmd, int flags)
+{
+  unwrap(this->try_put_genl(family, cmd, flags));
+}
+
+
+expected<> nlmsg_t::try_put_genl(int family, nl80211_commands cmd, 
+                                 int flags) noexcept
+{
+  return this->try_put_genl(family, static_cast<uint8_t>(cmd), flags);
+}
+
+
+expected<> nlmsg_t::try_put_genl(int family, uint8_t cmd, int flags) noexcept
 {
   void* errPtr = genlmsg_put(msgPtr_, 0, 0, family, 0, flags, cmd, 0);
   if(!errPtr) {
-    throw std::runtime_error{"genlmsg_put() error"};
+    return std::unexpected{error::from_nlerr(-NLE_NOMEM, cmd, "genlmsg_put")};
   }
+
+  return {};
 }
 
 
 struct nlmsghdr* nlmsg_t::nlmsg_hdr() noexcept
 { 
   return ::nlmsg_hdr(msgPtr_); 
-}
\ No newline at end of file
+}
+
+
+//* nlnest_t / / / / / / / / / / / / / / / / / / / / / / / / / / / / / / / / / /
+
+
+nlnest_t::nlnest_t(struct nl_msg* msgPtr, struct nlattr* attrPtr) noexcept
+: msgPtr_{msgPtr}, attrPtr_{attrPtr}
+{
+}
+
+
+nlnest_t::nlnest_t(nlnest_t&& other) noexcept
+{
+  msgPtr_ = std::exchange(other.msgPtr_, nullptr);
+  attrPtr_ = std::exchange(other.attrPtr_, nullptr);
+}
+
+
+nlnest_t& nlnest_t::operator=(nlnest_t&& rhs) noexcept
+{
+  nlnest_t moved{std::move(rhs)};
+  swap(*this, moved);
+
+  return *this;
+}
+
+
+nlnest_t::~nlnest_t()
+{
+  this->end();
+}
+
+
+void nlnest_t::end() noexcept
+{
+  if(attrPtr_) {
+    nla_nest_end(msgPtr_, std::exchange(attrPtr_, nullptr));
+  }
+}
+
+
+void nlnest_t::cancel() noexcept
+{
+  if(attrPtr_) {
+    nla_nest_cancel(msgPtr_, std::exchange(attrPtr_, nullptr));
+  }
+}
@@ -85,31 +85,149 @@ std::string_view nlpp::to_string(if_type_e const type)
 }
 
 
+bool channel_set_t::contains(channel_freq_t const chan) const noexcept
+{
+  auto const c = chan.get();
+
+  // channel numbers repeat across bands: 2.4/5/6 GHz on the grid, then 60 GHz
+  return this->contains(chan2freq(chan)) 
+    || (c > 0 && static_cast<std::size_t>(c) <= dmg_size 
+      && bits_[dmg_offset + c - 1]);
+}
+
+
+std::vector<frequency_t> channel_set_t::freqs() const
+{
+  std::vector<frequency_t> result;
+  result.reserve(this->size());
+
+  for(std::size_t i = 0; i != ism_size; ++i) {
+    if(bits_[i]) {
+      result.emplace_back(ism_first + i * ism_step);
+    }
+  }
+  if(bits_[ism_size]) {
+    result.emplace_back(ism_ch14);
+  }
+  for(std::size_t i = 0; i != grid_size; ++i) {
+    if(bits_[grid_offset + i]) {
+      result.emplace_back(grid_first + i * grid_step);
+    }
+  }
+  for(std::size_t i = 0; i != dmg_size; ++i) {
+    if(bits_[dmg_offset + i]) {
+      result.emplace_back(dmg_first + i * dmg_step);
+    }
+  }
+
+  return result;
+}
+
+
 bool dev_capability_t::is_supported(if_type_e const mode) const 
 {
-  return 
-    std::ranges::find(this->iftypes, mode) != std::ranges::end(this->iftypes);
+  auto const bit = static_cast<std::size_t>(std::to_underlying(mode));
+
+  return bit < this->iftypes.size() && this->iftypes[bit];
+}
+
+
+std::optional<std::size_t> 
+wiphy_channels_t::find(frequency_t const freq) const noexcept
+{
+  auto const found = std::ranges::find(this->freqs, freq);
+  if(found == std::ranges::end(this->freqs)) {
+    return std::nullopt;
+  }
+
+  return static_cast<std::size_t>(found - std::ranges::begin(this->freqs));
 }
 
 
 bool dev_capability_t::is_supported(frequency_t const freq) const 
 {
-  return 
-    std::ranges::find(this->freqs, freq) != std::ranges::end(this->freqs);
+  return this->channels.supported.contains(freq);
 }
 
 
 bool dev_capability_t::is_supported(channel_freq_t const chan) const 
 {
-  return
-    std::ranges::find(this->freqs, chan, freq2chan) 
-      != std::ranges::end(this->freqs);
+  return this->channels.supported.contains(chan);
+}
+
+
+bool dev_capability_t::is_usable(frequency_t const freq) const 
+{
+  return this->channels.usable.contains(freq);
+}
+
+
+bool dev_capability_t::is_usable(channel_freq_t const chan) const 
+{
+  return this->channels.usable.contains(chan);
+}
+
+
+std::vector<frequency_t> 
+dev_capability_t::usable_freqs(std::initializer_list<channel_flag_e> excluded) const
+{
+  auto mask = static_cast<uint8_t>(channel_flag_e::disabled);
+  for(auto flag: excluded) {
+    mask |= static_cast<uint8_t>(flag);
+  }
+
+  std::vector<frequency_t> result;
+  result.reserve(this->channels.size());
+
+  // a single pass over two contiguous columns
+  for(std::size_t i = 0; i != this->channels.size(); ++i) 
+  {
+    if(!(this->channels.flags[i] & mask)) {
+      result.push_back(this->channels.freqs[i]);
+    }
+  }
+
+  return result;
 }
 
 
 bool dev_capability_t::is_supported(nl80211_command_e const cmd) const 
 {
-  return std::ranges::find(this->cmds, cmd) != std::ranges::end(this->cmds);
+  auto const bit = static_cast<std::size_t>(std::to_underlying(cmd));
+
+  return bit < this->cmds.size() && this->cmds[bit];
+}
+
+
+capability_set_t dev_capability_t::sets() const noexcept
+{
+  return {this->iftypes, this->cmds, this->channels.usable};
+}
+
+
+capability_set_t nlpp::intersect(std::map<uint32_t,dev_capability_t> const& phys) noexcept
+{
+  if(phys.empty()) {
+    return {};
+  }
+
+  auto result = std::begin(phys)->second.sets();
+  for(auto const& [_, phy]: phys) {
+    result = result & phy.sets();
+  }
+
+  return result;
+}
+
+
+capability_set_t nlpp::unite(std::map<uint32_t,dev_capability_t> const& phys) noexcept
+{
+  capability_set_t result;
+  for(auto const& [_, phy]: phys) {
+    result = result | phy.sets();
+  }
+
+  return result;
 }
 
 
@@ -327,24 +445,32 @@ std::string nlpp::to_string(dev_capability_t const& dev)
 
   // get the interface types
   std::string iftypes;
-  for(auto type: dev.iftypes) {
-    iftypes += to_string(type);
-		iftypes += ",";
+  for(std::size_t i = 0; i != dev.iftypes.size(); ++i) 
+  {
+    if(dev.iftypes[i]) {
+      iftypes += to_string(static_cast<if_type_e>(i));
+      iftypes += ",";
+    }
   }
   iftypes.pop_back();
 
-  // get the frequencies
+  // get the frequencies, disabled ones marked with a `!`
   std::string freqs;
-  for(auto freq: dev.freqs) {
-    freqs += to_string(freq.get()) + ',';
+  for(std::size_t i = 0; i != dev.channels.size(); ++i) 
+  {
+    freqs += to_string(dev.channels.freqs[i].get());
+    freqs += dev.channels.has(i, channel_flag_e::disabled) ? "!," : ",";
   }
   freqs.pop_back();
 
   // get supported commands
   std::string cmds;
-  for(auto cmd: dev.cmds) {
-    cmds += to_string(cmd);
-		cmds += ",";
+  for(std::size_t i = 0; i != dev.cmds.size(); ++i) 
+  {
+    if(dev.cmds[i]) {
+      cmds += to_string(static_cast<nl80211_command_e>(i));
+      cmds += ",";
+    }
   }
   cmds.pop_back();
 
@@ -0,0 +1,211 @@
+#include "nlreactor_t.hpp"
+
+
+#include <sys/epoll.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <numeric>
+#include <system_error>
+
+
+using namespace nlpp;
+
+
+nlreactor_t::nlreactor_t()
+: epollFd_{epoll_create1(EPOLL_CLOEXEC)}
+{
+  if(epollFd_ < 0) {
+    throw std::system_error{errno, std::system_category(), "epoll_create1"};
+  }
+}
+
+
+nlreactor_t::nlreactor_t(nlreactor_t&& other) noexcept
+{
+  epollFd_ = std::exchange(other.epollFd_, -1);
+  sockets_ = std::exchange(other.sockets_, {});
+  ready_ = std::exchange(other.ready_, {});
+  readyHead_ = std::exchange(other.readyHead_, nullptr);
+  readyTail_ = std::exchange(other.readyTail_, nullptr);
+}
+
+
+nlreactor_t& nlreactor_t::operator=(nlreactor_t&& rhs) noexcept
+{
+  nlreactor_t moved{std::move(rhs)};
+  swap(*this, moved);
+
+  return *this;
+}
+
+
+nlreactor_t::~nlreactor_t()
+{
+  if(epollFd_ >= 0) {
+    ::close(epollFd_);
+  }
+}
+
+
+std::size_t nlreactor_t::pending() const noexcept
+{
+  return std::accumulate(std::begin(sockets_), std::end(sockets_),
+    std::size_t{}, [](auto sum, auto* socket) { return sum + socket->pending(); });
+}
+
+
+void nlreactor_t::add(nlsocket_t& socket)
+{
+  socket.set_nonblocking();
+
+  struct epoll_event event{};
+  event.events = EPOLLIN;
+  event.data.ptr = &socket;
+
+  if(epoll_ctl(epollFd_, EPOLL_CTL_ADD, socket.fd(), &event) < 0) {
+    throw std::system_error{errno, std::system_category(), "epoll_ctl"};
+  }
+
+  sockets_.push_back(&socket);
+}
+
+
+void nlreactor_t::remove(nlsocket_t& socket) noexcept
+{
+  epoll_ctl(epollFd_, EPOLL_CTL_DEL, socket.fd(), nullptr);
+
+  std::erase(sockets_, &socket);
+}
+
+
+std::size_t nlreactor_t::run_once(int timeout_ms)
+{
+  if(this->has_ready()) {
+    return this->resume_ready();
+  }
+
+  std::array<struct epoll_event, 64> events;
+
+  int ready = epoll_wait(epollFd_, events.data(), events.size(), timeout_ms);
+  if(ready < 0)
+  {
+    if(errno == EINTR) {
+      return 0;
+    }
+    throw std::system_error{errno, std::system_category(), "epoll_wait"};
+  }
+
+  for(int i = 0; i != ready; ++i) {
+    reinterpret_cast<nlsocket_t*>(events[i].data.ptr)->dispatch();
+  }
+
+  this->resume_ready();
+
+  return static_cast<std::size_t>(ready);
+}
+
+
+void nlreactor_t::run()
+{
+  while(this->pending() > 0 || this->has_ready()) {
+    this->run_once();
+  }
+}
+
+
+bool nlreactor_t::run(std::chrono::milliseconds timeout)
+{
+  return this->run_until(std::chrono::steady_clock::now() + timeout);
+}
+
+
+bool nlreactor_t::run_until(std::chrono::steady_clock::time_point deadline)
+{
+  while(this->pending() > 0 || this->has_ready())
+  {
+    auto const left = std::chrono::ceil<std::chrono::milliseconds>(
+      deadline - std::chrono::steady_clock::now());
+
+    if(left.count() > 0 || this->has_ready()) 
+    {
+      this->run_once(static_cast<int>(std::max<std::chrono::milliseconds::rep>(
+        left.count(), 0)));
+      continue;
+    }
+
+    // the replies may be lost: fail the requests, so their awaiters resume
+    for(auto* socket: sockets_) {
+      socket->expire(-ETIMEDOUT);
+    }
+    this->resume_ready();
+
+    return false;
+  }
+
+  return true;
+}
+
+
+void nlreactor_t::schedule(std::coroutine_handle<> handle)
+{
+  ready_.push_back(handle);
+}
+
+
+void nlreactor_t::schedule(request_awaiter& awaiter) noexcept
+{
+  awaiter.next_ = nullptr;
+
+  if(readyTail_) {
+    readyTail_->next_ = &awaiter;
+  }
+  else {
+    readyHead_ = &awaiter;
+  }
+  readyTail_ = &awaiter;
+}
+
+
+nlreactor_t::request_awaiter nlreactor_t::async_send(nlsocket_t& socket, 
+                                                     nlmsg_t msg, 
+                                                     nl_recvmsg_msg_cb_t fun, 
+                                                     void* arg)
+{
+  return request_awaiter{*this, socket, std::move(msg), fun, arg};
+}
+
+
+bool nlreactor_t::has_ready() const noexcept
+{
+  return readyHead_ || !ready_.empty();
+}
+
+
+std::size_t nlreactor_t::resume_ready()
+{
+  // a resumed coroutine may schedule again, so resume detached lists
+  auto* awaiter = std::exchange(readyHead_, nullptr);
+  readyTail_ = nullptr;
+  auto ready = std::exchange(ready_, {});
+
+  std::size_t resumed = ready.size();
+
+  while(awaiter)
+  {
+    // the awaiter lives in the coroutine frame, which may be gone once resumed
+    auto const handle = awaiter->handle_;
+    awaiter = awaiter->next_;
+
+    handle.resume();
+    ++resumed;
+  }
+
+  for(auto handle: ready) {
+    handle.resume();
+  }
+
+  return resumed;
+}
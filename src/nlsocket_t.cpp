@@ -1,9 +1,18 @@
 #include "nlsocket_t.hpp"
 
 
+#include <algorithm>
+#include <climits>
+#include <cstring>
 #include <system_error>
 
+#include <netlink/msg.h>
+#include <netlink/errno.h>
+#include <netlink/genl/genl.h>
 #include <netlink/netlink.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
 
 
 using namespace nlpp;
@@ -16,6 +25,10 @@ nlsocket_t::nlsocket_t()
     throw std::system_error{ENOMEM, std::system_category(),  
       "failed to allocate netlink socket."};
   }
+
+  // reuse the callback set allocated by `nl_socket_alloc()` for all requests
+  callback_ = nlcb_t{nl_socket_get_cb(socketPtr_)};
+  this->bind_handlers();
 }
 
 
@@ -31,6 +44,22 @@ nlsocket_t::nlsocket_t(nlsocket_t&& other) noexcept
   socketPtr_ = std::exchange(other.socketPtr_, nullptr);
   connected_ = std::exchange(other.connected_, {});
   callback_ = std::exchange(other.callback_, {});
+  inflight_ = std::exchange(other.inflight_, {});
+  nonblocking_ = std::exchange(other.nonblocking_, {});
+  protocol_ = std::exchange(other.protocol_, {});
+  timeout_ = std::exchange(other.timeout_, no_timeout);
+  rcvtimeo_ = std::exchange(other.rcvtimeo_, no_timeout);
+  seq_expect_ = std::exchange(other.seq_expect_, {});
+  msg_buf_size_ = std::exchange(other.msg_buf_size_, {});
+  autotune_ = std::exchange(other.autotune_, {});
+  ack_handler_ = std::exchange(other.ack_handler_, {});
+  errors_ = std::exchange(other.errors_, {});
+  rawBuf_ = std::move(other.rawBuf_);
+  rawSize_ = std::exchange(other.rawSize_, {});
+  iov_ = std::exchange(other.iov_, {});
+  last_cmd_ = std::exchange(other.last_cmd_, {});
+
+  this->bind_handlers();
 }
 
 
@@ -55,16 +84,48 @@ struct nl_sock* nlsocket_t::get_pointer() const noexcept
 }
 
 
+int nlsocket_t::fd() const noexcept
+{
+  return socketPtr_ ? nl_socket_get_fd(socketPtr_) : -1;
+}
+
+
+int nlsocket_t::rcvbuf() const noexcept
+{
+  int bytes{};
+  socklen_t len = sizeof(bytes);
+
+  if(::getsockopt(this->fd(), SOL_SOCKET, SO_RCVBUF, &bytes, &len) < 0) {
+    return -1;
+  }
+
+  return bytes;
+}
+
+
 void nlsocket_t::connect(netlink_protocol_e protocol)
+{
+  unwrap(this->try_connect(protocol));
+}
+
+
+expected<> nlsocket_t::try_connect(netlink_protocol_e protocol) noexcept
 {
   int const connectResult 
     = nl_connect(socketPtr_, std::to_underlying(protocol));
     
-  if(connectResult) {
-    throw std::system_error{connectResult, std::system_category()};
+  if(connectResult < 0) {
+    return std::unexpected{error::from_nlerr(connectResult, {}, "nl_connect")};
   }
 
   this->connected_ = true;
+  this->protocol_ = protocol;
+
+  if(int err = this->apply_rcvtimeo(timeout_); err) {
+    return std::unexpected{error::from_errno(err, {}, "setsockopt")};
+  }
+
+  return {};
 }
 
 
@@ -75,40 +136,980 @@ void nlsocket_t::close()
 }
 
 
+void nlsocket_t::set_nonblocking()
+{
+  unwrap(this->try_set_nonblocking());
+}
+
+
+expected<> nlsocket_t::try_set_nonblocking() noexcept
+{
+  int err = nl_socket_set_nonblocking(socketPtr_);
+  if(err < 0) {
+    return std::unexpected{
+      error::from_nlerr(err, {}, "nl_socket_set_nonblocking")};
+  }
+
+  this->nonblocking_ = true;
+
+  return {};
+}
+
+
+void nlsocket_t::set_timeout(std::chrono::milliseconds timeout)
+{
+  unwrap(this->try_set_timeout(timeout));
+}
+
+
+expected<> nlsocket_t::try_set_timeout(std::chrono::milliseconds timeout) noexcept
+{
+  this->timeout_ = timeout < std::chrono::milliseconds{} ? no_timeout : timeout;
+
+  if(!connected_) {
+    return {}; // applied by `try_connect()`
+  }
+
+  if(int err = this->apply_rcvtimeo(timeout_); err) {
+    return std::unexpected{error::from_errno(err, {}, "setsockopt")};
+  }
+
+  return {};
+}
+
+
+void nlsocket_t::set_rcvbuf(int bytes, bool force)
+{
+  unwrap(this->try_set_rcvbuf(bytes, force));
+}
+
+
+expected<> nlsocket_t::try_set_rcvbuf(int bytes, bool force) noexcept
+{
+  if(force 
+    && ::setsockopt(this->fd(), SOL_SOCKET, SO_RCVBUFFORCE, &bytes, sizeof(bytes)) == 0) {
+    return {};
+  }
+
+  // without `CAP_NET_ADMIN` the kernel caps the size to `rmem_max`
+  if(::setsockopt(this->fd(), SOL_SOCKET, SO_RCVBUF, &bytes, sizeof(bytes)) < 0) {
+    return std::unexpected{error::from_errno(errno, {}, "setsockopt")};
+  }
+
+  return {};
+}
+
+
+void nlsocket_t::set_msg_buf_size(std::size_t bytes)
+{
+  unwrap(this->try_set_msg_buf_size(bytes));
+}
+
+
+expected<> nlsocket_t::try_set_msg_buf_size(std::size_t bytes) noexcept
+{
+  int err = nl_socket_set_msg_buf_size(socketPtr_, bytes);
+  if(err < 0) {
+    return std::unexpected{
+      error::from_nlerr(err, {}, "nl_socket_set_msg_buf_size")};
+  }
+
+  this->msg_buf_size_ = bytes;
+
+  return {};
+}
+
+
+void nlsocket_t::set_peek(bool enable) noexcept
+{
+  enable ? nl_socket_enable_msg_peek(socketPtr_) 
+         : nl_socket_disable_msg_peek(socketPtr_);
+}
+
+
+void nlsocket_t::set_no_enobufs(bool enable)
+{
+  unwrap(this->try_set_no_enobufs(enable));
+}
+
+
+expected<> nlsocket_t::try_set_no_enobufs(bool enable) noexcept
+{
+  int const value = enable;
+
+  if(::setsockopt(this->fd(), SOL_NETLINK, NETLINK_NO_ENOBUFS, 
+                  &value, sizeof(value)) < 0) {
+    return std::unexpected{error::from_errno(errno, {}, "setsockopt")};
+  }
+
+  return {};
+}
+
+
+void nlsocket_t::set_cap_ack(bool enable)
+{
+  unwrap(this->try_set_cap_ack(enable));
+}
+
+
+expected<> nlsocket_t::try_set_cap_ack(bool enable) noexcept
+{
+  int const value = enable;
+
+  if(::setsockopt(this->fd(), SOL_NETLINK, NETLINK_CAP_ACK, 
+                  &value, sizeof(value)) < 0) {
+    return std::unexpected{error::from_errno(errno, {}, "setsockopt")};
+  }
+
+  return {};
+}
+
+
+void nlsocket_t::set_strict_check(bool enable)
+{
+  unwrap(this->try_set_strict_check(enable));
+}
+
+
+expected<> nlsocket_t::try_set_strict_check(bool enable) noexcept
+{
+  int const value = enable;
+
+  if(::setsockopt(this->fd(), SOL_NETLINK, NETLINK_GET_STRICT_CHK, 
+                  &value, sizeof(value)) < 0) {
+    return std::unexpected{error::from_errno(errno, {}, "setsockopt")};
+  }
+
+  return {};
+}
+
+
+void nlsocket_t::add_membership(uint32_t group)
+{
+  unwrap(this->try_add_membership(group));
+}
+
+
+expected<> nlsocket_t::try_add_membership(uint32_t group) noexcept
+{
+  int err = nl_socket_add_membership(socketPtr_, static_cast<int>(group));
+  if(err < 0) {
+    return std::unexpected{
+      error::from_nlerr(err, {}, "nl_socket_add_membership")};
+  }
+
+  return {};
+}
+
+
 void nlsocket_t::set_cb(nlcb_t cb)
 {
   this->callback_ = std::move(cb);
+  this->bind_handlers();
   nl_socket_set_cb(socketPtr_, this->callback_.get_pointer());
 }
 
 
 void nlsocket_t::send_auto(nlmsg_t const& msg)
 {
+  unwrap(this->try_send_auto(msg));
+}
+
+
+expected<> nlsocket_t::try_send_auto(nlmsg_t const& msg) noexcept
+{
+  return this->try_send_seq(msg, nl_socket_use_seq(socketPtr_));
+}
+
+
+void nlsocket_t::recvmsgs(nl_recvmsg_msg_cb_t fun, void* arg,
+                          std::optional<std::chrono::milliseconds> timeout)
+{
+  unwrap(this->try_recvmsgs(fun, arg, timeout));
+}
+
+
+expected<> nlsocket_t::try_recvmsgs(
+  nl_recvmsg_msg_cb_t fun, void* arg,
+  std::optional<std::chrono::milliseconds> timeout) noexcept
+{
+  auto const deadline = this->deadline_of(timeout);
+
+  if(int err = this->apply_rcvtimeo(timeout.value_or(timeout_)); err) {
+    return std::unexpected{error::from_errno(err, last_cmd_, "setsockopt")};
+  }
+
+  // only the valid-message handler changes between requests
+  nl_cb_set(callback_.get_pointer(), NL_CB_VALID, 
+    fun ? NL_CB_CUSTOM : NL_CB_DEFAULT, fun, arg);
+
+  status_ = 1;
+
+  expected<> result;
+
+  while(status_ > 0 && result) 
+  {
+    if(int err = this->wait_readable(deadline); err) {
+      result = std::unexpected{error::from_errno(err, last_cmd_, 
+        err == ETIMEDOUT ? "recvmsgs" : "poll")};
+    }
+    // `-NLE_AGAIN`: `SO_RCVTIMEO` expired inside a multipart reply, wait again
+    else if(err = nl_recvmsgs(socketPtr_, callback_.get_pointer()); 
+            err < 0 && err != -NLE_AGAIN && status_ > 0) {
+      result = std::unexpected{this->recv_error(err, last_cmd_)};
+    }
+  }
+
+  if(timeout) {
+    this->apply_rcvtimeo(timeout_); // restore the socket default
+  }
+
+  if(result && status_ < 0) {
+    return std::unexpected{error::from_errno(status_, last_cmd_, "recvmsgs")};
+  }
+
+  return result;
+}
+
+
+void nlsocket_t::recv_raw(nlview_cb_t fun, void* arg,
+                          std::optional<std::chrono::milliseconds> timeout)
+{
+  unwrap(this->try_recv_raw(fun, arg, timeout));
+}
+
+
+expected<> nlsocket_t::try_recv_raw(
+  nlview_cb_t fun, void* arg,
+  std::optional<std::chrono::milliseconds> timeout) noexcept
+{
+  if(int err = this->reserve_raw(); err) {
+    return std::unexpected{error::from_errno(err, last_cmd_, "recv_raw")};
+  }
+
+  auto const deadline = this->deadline_of(timeout);
+
+  for(;;)
+  {
+    auto done = this->try_recv_datagram(fun, arg, deadline);
+    if(!done) {
+      return std::unexpected{done.error()};
+    }
+    if(*done) {
+      return {};
+    }
+  }
+}
+
+
+bool nlsocket_t::recv_raw_next(nlview_cb_t fun, void* arg,
+                               std::optional<std::chrono::milliseconds> timeout)
+{
+  return unwrap(this->try_recv_raw_next(fun, arg, timeout));
+}
+
+
+expected<bool> nlsocket_t::try_recv_raw_next(
+  nlview_cb_t fun, void* arg,
+  std::optional<std::chrono::milliseconds> timeout) noexcept
+{
+  if(int err = this->reserve_raw(); err) {
+    return std::unexpected{error::from_errno(err, last_cmd_, "recv_raw")};
+  }
+
+  return this->try_recv_datagram(fun, arg, this->deadline_of(timeout));
+}
+
+
+void nlsocket_t::recvmsgs(nlcb_t& cb, 
+                          std::optional<std::chrono::milliseconds> timeout)
+{
+  unwrap(this->try_recvmsgs(cb, timeout));
+}
+
+
+expected<> nlsocket_t::try_recvmsgs(
+  nlcb_t& cb, std::optional<std::chrono::milliseconds> timeout) noexcept
+{
+  auto* cbPtr = cb.get_pointer();
+  int status = 1; // set by the handlers, as `status_`
+
+  nl_cb_err(cbPtr, NL_CB_CUSTOM, nlsocket_t::error_handler, &status);
+  nl_cb_set(cbPtr, NL_CB_FINISH, NL_CB_CUSTOM, nlsocket_t::finish_handler, &status);
+  nl_cb_set(cbPtr, NL_CB_ACK, NL_CB_CUSTOM, nlsocket_t::ack_handler, &status);
+
+  auto const deadline = this->deadline_of(timeout);
+
+  if(int err = this->apply_rcvtimeo(timeout.value_or(timeout_)); err) {
+    return std::unexpected{error::from_errno(err, last_cmd_, "setsockopt")};
+  }
+
+  expected<> result;
+
+  // as `try_recvmsgs()` with the persistent callback set
+  while(status > 0 && result) 
+  {
+    if(int err = this->wait_readable(deadline); err) {
+      result = std::unexpected{error::from_errno(err, last_cmd_, 
+        err == ETIMEDOUT ? "recvmsgs" : "poll")};
+    }
+    else if(err = nl_recvmsgs(socketPtr_, cbPtr); 
+            err < 0 && err != -NLE_AGAIN && status > 0) {
+      result = std::unexpected{this->recv_error(err, last_cmd_)};
+    }
+  }
+
+  if(timeout) {
+    this->apply_rcvtimeo(timeout_); // restore the socket default
+  }
+
+  if(result && status < 0) {
+    return std::unexpected{error::from_errno(status, last_cmd_, "recvmsgs")};
+  }
+
+  return result;
+}
+
+
+void nlsocket_t::send_batch(std::span<nlrequest_t> batch)
+{
+  unwrap(this->try_send_batch(batch));
+}
+
+
+expected<> nlsocket_t::try_send_batch(std::span<nlrequest_t> batch) noexcept
+{
+  iov_.clear();
+
+  for(auto& request: batch)
+  {
+    auto* hdr = ::nlmsg_hdr(request.msg->get_pointer());
+    hdr->nlmsg_seq = NL_AUTO_SEQ; // a resent message gets a new one as well
+
+    nl_complete_msg(socketPtr_, request.msg->get_pointer()); // assign seq
+
+    request.seq = hdr->nlmsg_seq;
+    request.error = 1;
+    request.cmd = this->command_of(*request.msg);
+
+    try {
+      iov_.push_back({hdr, hdr->nlmsg_len});
+    }
+    catch(std::bad_alloc const&) {
+      return std::unexpected{error::from_errno(ENOMEM, {}, "send_batch")};
+    }
+  }
+
+  struct sockaddr_nl peer{};
+  peer.nl_family = AF_NETLINK;
+  peer.nl_pid = nl_socket_get_peer_port(socketPtr_);
+
+  // the kernel walks every `nlmsghdr` of a datagram, so the whole batch fits a
+  // single `sendmsg()` unless it exceeds `IOV_MAX` or the socket send buffer:
+  // `netlink_sendmsg()` refuses a datagram larger than `SO_SNDBUF` - 32
+  int sndbuf{};
+  socklen_t len = sizeof(sndbuf);
+
+  if(::getsockopt(this->fd(), SOL_SOCKET, SO_SNDBUF, &sndbuf, &len) < 0) {
+    return std::unexpected{error::from_errno(errno, {}, "getsockopt")};
+  }
+
+  auto const max_datagram = static_cast<std::size_t>(std::max(sndbuf - 32, 0));
+
+  for(std::size_t first = 0; first < iov_.size(); )
+  {
+    std::size_t last = first;
+    std::size_t bytes = 0;
+
+    while(last < iov_.size() && last - first < IOV_MAX
+      && (last == first || bytes + iov_[last].iov_len <= max_datagram)) 
+    {
+      bytes += iov_[last++].iov_len;
+    }
+
+    struct msghdr msg{};
+    msg.msg_name = &peer;
+    msg.msg_namelen = sizeof(peer);
+    msg.msg_iov = iov_.data() + first;
+    msg.msg_iovlen = last - first;
+
+    if(::sendmsg(nl_socket_get_fd(socketPtr_), &msg, 0) < 0) {
+      return std::unexpected{error::from_errno(errno, {}, "sendmsg")};
+    }
+
+    first = last;
+  }
+
+  return {};
+}
+
+
+void nlsocket_t::recv_batch(std::span<nlrequest_t> batch,
+                            std::optional<std::chrono::milliseconds> timeout)
+{
+  unwrap(this->try_recv_batch(batch, timeout));
+}
+
+
+expected<> nlsocket_t::try_recv_batch(
+  std::span<nlrequest_t> batch,
+  std::optional<std::chrono::milliseconds> timeout) noexcept
+{
+  auto* cbPtr = callback_.get_pointer();
+  auto const deadline = this->deadline_of(timeout);
+
+  if(int err = this->apply_rcvtimeo(timeout.value_or(timeout_)); err) {
+    return std::unexpected{error::from_errno(err, {}, "setsockopt")};
+  }
+
+  batch_ = batch;
+  pending_ = std::ranges::count_if(batch, [](auto& r) { return r.error > 0; });
+
+  this->install_seq_handlers(); // temporarily route replies by seq
+
+  expected<> result;
+
+  while(pending_ > 0 && result) 
+  {
+    if(int err = this->wait_readable(deadline); err) {
+      result = std::unexpected{error::from_errno(err, {}, 
+        err == ETIMEDOUT ? "recv_batch" : "poll")};
+    }
+    else if(err = nl_recvmsgs(socketPtr_, cbPtr); 
+            err < 0 && err != -NLE_AGAIN) {
+      result = std::unexpected{this->recv_error(err, {})};
+    }
+  }
+
+  // requests left behind by an error never complete: their late replies are
+  // skipped by the sequence check
+  if(!result) 
+  {
+    for(auto& request: batch) {
+      if(request.error > 0) {
+        request.error = -result.error().to_errno();
+      }
+    }
+  }
+
+  batch_ = {};
+  pending_ = 0;
+  this->bind_handlers();
+
+  if(timeout) {
+    this->apply_rcvtimeo(timeout_); // restore the socket default
+  }
+
+  return result;
+}
+
+
+void nlsocket_t::transact(std::span<nlrequest_t> batch,
+                          std::optional<std::chrono::milliseconds> timeout)
+{
+  unwrap(this->try_transact(batch, timeout));
+}
+
+
+expected<> nlsocket_t::try_transact(
+  std::span<nlrequest_t> batch,
+  std::optional<std::chrono::milliseconds> timeout) noexcept
+{
+  if(auto sent = this->try_send_batch(batch); !sent) {
+    return sent;
+  }
+
+  return this->try_recv_batch(batch, timeout);
+}
+
+
+uint32_t nlsocket_t::send_async(nlmsg_t const& msg, 
+                                nl_recvmsg_msg_cb_t fun, 
+                                void* arg, 
+                                nlcompletion_t done)
+{
+  return unwrap(this->try_send_async(msg, fun, arg, std::move(done)));
+}
+
+
+expected<uint32_t> nlsocket_t::try_send_async(nlmsg_t const& msg, 
+                                              nl_recvmsg_msg_cb_t fun, 
+                                              void* arg, 
+                                              nlcompletion_t done) noexcept
+{
+  auto const seq = nl_socket_use_seq(socketPtr_);
+  auto const cmd = this->command_of(msg);
+
+  // register first, so that a failed allocation leaves nothing in flight
+  try {
+    inflight_.push_back({nullptr, fun, arg, seq, 1, std::move(done), cmd});
+  }
+  catch(std::bad_alloc const&) {
+    return std::unexpected{error::from_errno(ENOMEM, cmd, "send_async")};
+  }
+
+  // the blocking receives only wait for the replies of their own request
+  auto const seq_expect = seq_expect_;
+  auto sent = this->try_send_seq(msg, seq);
+  seq_expect_ = seq_expect;
+
+  if(!sent) 
+  {
+    inflight_.pop_back();
+    return std::unexpected{sent.error()};
+  }
+
+  return seq;
+}
+
+
+uint32_t nlsocket_t::send_nowait(nlmsg_t const& msg)
+{
+  return unwrap(this->try_send_nowait(msg));
+}
+
+
+expected<uint32_t> nlsocket_t::try_send_nowait(nlmsg_t const& msg) noexcept
+{
+  // without completion, the outcome is reported by `report()`
+  return this->try_send_async(msg, {}, {}, {});
+}
+
+
+void nlsocket_t::drain()
+{
+  unwrap(this->try_drain());
+}
+
+
+expected<> nlsocket_t::try_drain() noexcept
+{
+  while(!inflight_.empty())
+  {
+    int err = this->wait_readable(std::chrono::steady_clock::now());
+    if(err == ETIMEDOUT) {
+      break;  // nothing left to read
+    }
+    if(err) {
+      return std::unexpected{error::from_errno(err, {}, "poll")};
+    }
+
+    if(auto dispatched = this->try_dispatch(); !dispatched) {
+      return dispatched;
+    }
+  }
+
+  return {};
+}
+
+
+void nlsocket_t::flush(std::optional<std::chrono::milliseconds> timeout)
+{
+  unwrap(this->try_flush(timeout));
+}
+
+
+expected<> nlsocket_t::try_flush(
+  std::optional<std::chrono::milliseconds> timeout) noexcept
+{
+  auto const deadline = this->deadline_of(timeout);
+
+  while(!inflight_.empty())
+  {
+    if(int err = this->wait_readable(deadline); err) {
+      return std::unexpected{error::from_errno(err, {}, 
+        err == ETIMEDOUT ? "flush" : "poll")};
+    }
+
+    if(auto dispatched = this->try_dispatch(); !dispatched) {
+      return dispatched;
+    }
+  }
+
+  return {};
+}
+
+
+void nlsocket_t::dispatch()
+{
+  unwrap(this->try_dispatch());
+}
+
+
+expected<> nlsocket_t::try_dispatch() noexcept
+{
+  auto* cbPtr = callback_.get_pointer();
+
+  this->install_seq_handlers();
+
+  // `nl_recvmsgs_report()` returns 0 once a non-blocking socket is drained
+  int err = nl_recvmsgs_report(socketPtr_, cbPtr);
+  while(nonblocking_ && err > 0) {
+    err = nl_recvmsgs_report(socketPtr_, cbPtr);
+  }
+
+  this->bind_handlers();
+
+  if(err < 0 && err != -NLE_AGAIN) {
+    return std::unexpected{this->recv_error(err, {})};
+  }
+
+  return {};
+}
+
+
+void nlsocket_t::expire(int error) noexcept
+{
+  // a completion may send a request, which is appended
+  for(auto left = inflight_.size(); left != 0 && !inflight_.empty(); --left) {
+    this->complete(inflight_.front(), error);
+  }
+}
+
+
+int nlsocket_t::command_of(nlmsg_t const& msg) const noexcept
+{
+  auto const* hdr = ::nlmsg_hdr(msg.get_pointer());
+
+  if(protocol_ == netlink_protocol_e::generic) {
+    return reinterpret_cast<genlmsghdr const*>(nlmsg_data(hdr))->cmd;
+  }
+
+  return hdr->nlmsg_type;
+}
+
+
+expected<> nlsocket_t::try_send_seq(nlmsg_t const& msg, uint32_t seq) noexcept
+{
+  last_cmd_ = this->command_of(msg);
+
+  // `nl_send_auto()` only assigns a sequence number to a fresh message
+  ::nlmsg_hdr(msg.get_pointer())->nlmsg_seq = seq;
+
   int err = nl_send_auto(socketPtr_, msg.get_pointer());
   if(err < 0) {
-    throw std::runtime_error{nl_geterror(err)};
+    return std::unexpected{error::from_nlerr(err, last_cmd_, "nl_send_auto")};
   }
+
+  seq_expect_ = seq;
+
+  return {};
 }
 
 
-// TODO: valuta se mettere questa roba nel costruttore di `nlsocket_t` invece di
-// ripeterla ogni volta.
+void nlsocket_t::install_seq_handlers() noexcept
+{
+  auto* cbPtr = callback_.get_pointer();
+
+  nl_cb_err(cbPtr, NL_CB_CUSTOM, nlsocket_t::batch_error_handler, this);
+  nl_cb_set(cbPtr, NL_CB_VALID, NL_CB_CUSTOM, 
+    nlsocket_t::batch_valid_handler, this);
+  nl_cb_set(cbPtr, NL_CB_FINISH, NL_CB_CUSTOM, 
+    nlsocket_t::batch_done_handler, this);
+  nl_cb_set(cbPtr, NL_CB_ACK, NL_CB_CUSTOM, 
+    nlsocket_t::batch_done_handler, this);
+  nl_cb_set(cbPtr, NL_CB_SEQ_CHECK, NL_CB_CUSTOM, 
+    nlsocket_t::batch_seq_handler, this);
+}
+
 
-void nlsocket_t::recvmsgs(nlcb_t& cb)
+std::optional<std::chrono::steady_clock::time_point> 
+nlsocket_t::deadline_of(std::optional<std::chrono::milliseconds> timeout) const noexcept
 {
-  int err = 1;
+  auto const effective = timeout.value_or(timeout_);
 
-  cb.err(NL_CB_CUSTOM, nlsocket_t::error_handler, &err);
-  cb.set(NL_CB_FINISH, NL_CB_CUSTOM, nlsocket_t::finish_handler, &err);
-  cb.set(NL_CB_ACK, NL_CB_CUSTOM, nlsocket_t::ack_handler, &err);
+  if(effective < std::chrono::milliseconds{}) {
+    return {};
+  }
+
+  return std::chrono::steady_clock::now() + effective;
+}
 
-  while(err > 0) {
-    nl_recvmsgs(socketPtr_, cb.get_pointer());
+
+int nlsocket_t::apply_rcvtimeo(std::chrono::milliseconds timeout) noexcept
+{
+  if(timeout < std::chrono::milliseconds{}) {
+    timeout = no_timeout;
   }
 
-  if(err < 0) {
-    throw std::system_error{std::abs(err), std::system_category()};
+  // a non-blocking socket never waits in `recvmsg()`, `poll()` enforces it
+  if(!connected_ || nonblocking_ || timeout == rcvtimeo_) {
+    return 0;
+  }
+
+  using namespace std::chrono;
+
+  struct timeval tv{}; // zero waits forever
+  if(timeout > milliseconds{}) 
+  {
+    auto const secs = duration_cast<seconds>(timeout);
+    tv.tv_sec = secs.count();
+    tv.tv_usec = duration_cast<microseconds>(timeout - secs).count();
   }
+  else if(timeout == milliseconds{}) {
+    tv.tv_usec = 1; // smallest non-infinite timeout
+  }
+
+  if(::setsockopt(this->fd(), SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv)) < 0) {
+    return errno;
+  }
+
+  rcvtimeo_ = timeout;
+
+  return 0;
+}
+
+
+int nlsocket_t::reserve_raw() noexcept
+{
+  // a dump datagram never exceeds the buffer libnl would use, rounded to pages
+  auto const page = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+  auto const wanted = std::max(msg_buf_size_, dump_msg_buf_size);
+
+  if(!rawBuf_ || rawSize_ < wanted)
+  {
+    auto const bytes = (wanted + page - 1) / page * page;
+
+    rawBuf_.reset(static_cast<std::byte*>(std::aligned_alloc(page, bytes)));
+    rawSize_ = rawBuf_ ? bytes : 0;
+
+    if(!rawBuf_) {
+      return ENOMEM;
+    }
+  }
+
+  return 0;
+}
+
+
+expected<bool> nlsocket_t::try_recv_datagram(nlview_cb_t fun, void* arg,
+  std::optional<std::chrono::steady_clock::time_point> deadline) noexcept
+{
+  status_ = 1;
+
+  for(;;)
+  {
+    if(int err = this->wait_readable(deadline); err) {
+      return std::unexpected{error::from_errno(err, last_cmd_, 
+        err == ETIMEDOUT ? "recv_raw" : "poll")};
+    }
+
+    struct sockaddr_nl peer{};
+    struct iovec iov{rawBuf_.get(), rawSize_};
+    struct msghdr msg{};
+    msg.msg_name = &peer;
+    msg.msg_namelen = sizeof(peer);
+    msg.msg_iov = &iov;
+    msg.msg_iovlen = 1;
+
+    auto const len = ::recvmsg(this->fd(), &msg, 0);
+
+    if(len < 0)
+    {
+      if(errno == EINTR || errno == EAGAIN) {
+        continue; // signal, `SO_RCVTIMEO` or spurious wakeup: wait again
+      }
+
+      int const err = errno;
+      auto const grown = err == ENOBUFS ? this->grow_buffers(-NLE_NOMEM) : 0;
+
+      return std::unexpected{error::from_errno(grown ? grown : err, 
+        last_cmd_, "recvmsg")};
+    }
+
+    if(msg.msg_flags & MSG_TRUNC) 
+    {
+      // the rest of the datagram is lost, and so is the reply: in autotune 
+      // mode the buffers grow (`reserve_raw()` follows) so that a retry fits
+      if(autotune_)
+      {
+        if(auto grown = this->try_set_msg_buf_size(rawSize_ * 2); !grown) {
+          return std::unexpected{grown.error()};
+        }
+      }
+      return std::unexpected{error::from_errno(EMSGSIZE, last_cmd_, "recvmsg")};
+    }
+
+    if(peer.nl_pid != 0) {
+      continue; // not from the kernel
+    }
+
+    this->process_raw(static_cast<std::size_t>(len), fun, arg);
+    break;
+  }
+
+  if(status_ < 0) {
+    return std::unexpected{error::from_errno(status_, last_cmd_, "recv_raw")};
+  }
+
+  return status_ == 0;
+}
+
+
+void nlsocket_t::process_raw(std::size_t len, nlview_cb_t fun, void* arg) noexcept
+{
+  auto const* hdr = reinterpret_cast<struct nlmsghdr const*>(rawBuf_.get());
+  auto left = static_cast<int>(len);
+
+  for(; NLMSG_OK(hdr, left); hdr = NLMSG_NEXT(hdr, left))
+  {
+    // replies of asynchronous requests interleave with the blocking request
+    if(auto* request = this->find_request(hdr->nlmsg_seq); request) 
+    {
+      if(hdr->nlmsg_type == NLMSG_ERROR) {
+        auto const* err = reinterpret_cast<nlmsgerr const*>(NLMSG_DATA(hdr));
+        this->complete(*request, err->error);
+      }
+      else if(hdr->nlmsg_type == NLMSG_DONE) {
+        this->complete(*request, 0);
+      }
+      else if(request->fun) 
+      {
+        // rare: pay for a `struct nl_msg` only for the libnl-style handler
+        if(auto* msgPtr = ::nlmsg_convert(const_cast<nlmsghdr*>(hdr)); msgPtr) {
+          request->fun(msgPtr, request->arg);
+          ::nlmsg_free(msgPtr);
+        }
+      }
+      continue;
+    }
+
+    if(hdr->nlmsg_seq != seq_expect_) {
+      continue; // reply of an expired request
+    }
+
+    switch(hdr->nlmsg_type)
+    {
+      case NLMSG_NOOP:
+        continue;
+
+      case NLMSG_OVERRUN:
+        status_ = -EOVERFLOW;
+        return;
+
+      case NLMSG_ERROR: {
+        auto const* err = reinterpret_cast<nlmsgerr const*>(NLMSG_DATA(hdr));
+        status_ = hdr->nlmsg_len < NLMSG_LENGTH(sizeof(nlmsgerr)) 
+          ? -EBADMSG : err->error;
+        return;
+      }
+
+      case NLMSG_DONE: {
+        // the kernel may append the dump error to `NLMSG_DONE`
+        int err = 0;
+        if(hdr->nlmsg_len >= NLMSG_LENGTH(sizeof(int))) {
+          std::memcpy(&err, NLMSG_DATA(hdr), sizeof(int));
+        }
+        status_ = std::min(err, 0);
+        return;
+      }
+
+      default:
+        break;
+    }
+
+    if(hdr->nlmsg_flags & NLM_F_DUMP_INTR) {
+      status_ = -EINTR; // the dump changed while it was read: restart it
+      return;
+    }
+
+    // like libnl, skip the rest of the datagram, whose `NLMSG_DONE` or error
+    // still ends the reply
+    if(fun && fun(nlmsg_view_t{hdr}, arg) == NL_STOP) {
+      fun = nullptr;
+    }
+  }
+}
+
+
+int nlsocket_t::grow_buffers(int err) noexcept
+{
+  if(!autotune_) {
+    return 0;
+  }
+
+  if(err == -NLE_MSG_TRUNC)
+  {
+    auto const bytes = std::max(msg_buf_size_ * 2, dump_msg_buf_size);
+    return this->try_set_msg_buf_size(bytes) ? EMSGSIZE : 0;
+  }
+
+  // libnl reports the `ENOBUFS` of a receive queue overrun as `NLE_NOMEM`
+  if(err == -NLE_NOMEM)
+  {
+    int const current = this->rcvbuf(); // the kernel reports twice the size
+    if(current < 0 || current / 2 >= max_autotune_rcvbuf) {
+      return 0;
+    }
+
+    return this->try_set_rcvbuf(std::min(current, max_autotune_rcvbuf), true) 
+      ? ENOBUFS : 0;
+  }
+
+  return 0;
+}
+
+
+error nlsocket_t::recv_error(int err, int cmd) noexcept
+{
+  if(int grown = this->grow_buffers(err); grown) {
+    return error::from_errno(grown, cmd, "nl_recvmsgs");
+  }
+
+  return error::from_nlerr(err, cmd, "nl_recvmsgs");
+}
+
+
+int nlsocket_t::wait_readable(
+  std::optional<std::chrono::steady_clock::time_point> deadline) const noexcept
+{
+  using namespace std::chrono;
+
+  if(!nonblocking_ && !deadline) {
+    return 0; // `recvmsg()` blocks by itself
+  }
+
+  struct pollfd pfd{this->fd(), POLLIN, 0};
+
+  for(;;)
+  {
+    int timeout_ms = -1;
+
+    if(deadline) 
+    {
+      auto const left = ceil<milliseconds>(*deadline - steady_clock::now());
+      timeout_ms = static_cast<int>(std::max(left.count(), milliseconds::rep{}));
+    }
+
+    int const ready = ::poll(&pfd, 1, timeout_ms);
+
+    if(ready > 0) {
+      return 0;
+    }
+    if(ready == 0) {
+      return ETIMEDOUT;
+    }
+    if(errno != EINTR) {
+      return errno;
+    }
+  }
+}
+
+
+void nlsocket_t::bind_handlers() noexcept
+{
+  if(!callback_.get_pointer()) {
+    return; // moved-from socket
+  }
+
+  nl_cb_set(callback_.get_pointer(), NL_CB_SEQ_CHECK, NL_CB_CUSTOM, 
+    nlsocket_t::seq_handler, this);
+  nl_cb_err(callback_.get_pointer(), NL_CB_CUSTOM, 
+    nlsocket_t::error_handler, &status_);
+  nl_cb_set(callback_.get_pointer(), NL_CB_FINISH, NL_CB_CUSTOM, 
+    nlsocket_t::finish_handler, &status_);
+  nl_cb_set(callback_.get_pointer(), NL_CB_ACK, NL_CB_CUSTOM, 
+    nlsocket_t::ack_handler, &status_);
 }
 
 
@@ -136,4 +1137,144 @@ int nlsocket_t::ack_handler(nl_msg*, void* arg) noexcept
 	*ret = 0;
 
 	return NL_STOP;
+}
+
+
+int nlsocket_t::seq_handler(nl_msg* msg, void* arg) noexcept
+{
+  auto* self = reinterpret_cast<nlsocket_t*>(arg);
+  auto const* hdr = ::nlmsg_hdr(msg);
+
+  // replies of asynchronous requests interleave with the blocking request
+  if(auto* request = self->find_request(hdr->nlmsg_seq); request) 
+  {
+    if(hdr->nlmsg_type == NLMSG_ERROR) {
+      auto const* err = reinterpret_cast<nlmsgerr const*>(nlmsg_data(hdr));
+      self->complete(*request, err->error);
+    }
+    else if(hdr->nlmsg_type == NLMSG_DONE) {
+      self->complete(*request, 0);
+    }
+    else if(request->fun) {
+      request->fun(msg, request->arg);
+    }
+
+    return NL_SKIP;
+  }
+
+  // replies older than the last request belong to expired requests: drop 
+  // them. Newer ones come from libnl helpers sending on this socket.
+  auto const age = static_cast<int32_t>(hdr->nlmsg_seq - self->seq_expect_);
+
+  return age < 0 ? NL_SKIP : NL_OK;
+}
+
+
+nlrequest_t* nlsocket_t::find_request(uint32_t seq) noexcept
+{
+  if(auto found = std::ranges::find(batch_, seq, &nlrequest_t::seq); 
+     found != std::end(batch_)) {
+    return &*found;
+  }
+
+  auto found = std::ranges::find(inflight_, seq, &nlrequest_t::seq);
+
+  return found != std::end(inflight_) ? &*found : nullptr;
+}
+
+
+void nlsocket_t::complete(nlrequest_t& request, int error) noexcept
+{
+  if(request.error <= 0) {
+    return; // already completed
+  }
+
+  request.error = error;
+
+  auto const* first = inflight_.data();
+  auto const* last = first + inflight_.size();
+  std::less<nlrequest_t const*> const less;
+
+  if(less(&request, first) || !less(&request, last)) 
+  {
+    --pending_; // batch request
+    return;
+  }
+
+  // remove before invoking, since the completion may send a new request
+  auto done = std::move(request.done);
+  nlack_t const ack{request.seq, request.cmd, error};
+  inflight_.erase(inflight_.begin() + (&request - inflight_.data()));
+
+  if(done) {
+    done(error);
+  }
+  else {
+    this->report(ack);
+  }
+}
+
+
+void nlsocket_t::report(nlack_t const& ack) noexcept
+{
+  if(ack_handler_) {
+    ack_handler_(ack);
+    return;
+  }
+
+  if(ack.error) 
+  {
+    try {
+      errors_.push_back(ack);
+    }
+    catch(std::bad_alloc const&) {
+      // the error is lost, but the request is no longer in flight
+    }
+  }
+}
+
+
+int nlsocket_t::batch_valid_handler(nl_msg* msg, void* arg) noexcept
+{
+  auto* self = reinterpret_cast<nlsocket_t*>(arg);
+  auto* request = self->find_request(::nlmsg_hdr(msg)->nlmsg_seq);
+
+  if(!request || !request->fun) {
+    return NL_SKIP;
+  }
+
+  // a request handler must not stop the replies of the other requests
+  return request->fun(msg, request->arg) == NL_STOP ? NL_SKIP : NL_OK;
+}
+
+
+int nlsocket_t::batch_error_handler(sockaddr_nl*, nlmsgerr* err, void* arg) noexcept
+{
+  auto* self = reinterpret_cast<nlsocket_t*>(arg);
+  auto* request = self->find_request(err->msg.nlmsg_seq);
+
+  if(request) {
+    self->complete(*request, err->error);
+  }
+
+  return NL_SKIP;
+}
+
+
+int nlsocket_t::batch_done_handler(nl_msg* msg, void* arg) noexcept
+{
+  auto* self = reinterpret_cast<nlsocket_t*>(arg);
+  auto* request = self->find_request(::nlmsg_hdr(msg)->nlmsg_seq);
+
+  if(request) {
+    self->complete(*request, 0);
+  }
+
+  return NL_SKIP;
+}
+
+
+int nlsocket_t::batch_seq_handler(nl_msg*, void*) noexcept
+{
+  return NL_OK;
 }
\ No newline at end of file
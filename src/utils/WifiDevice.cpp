@@ -2,12 +2,15 @@
 
 
 #include <format>
+#include <future>
 
 
 namespace nlpp {
 
 
-WifiDevice::WifiDevice(std::string const& ifname, nlpp::if_type_e if_type)
+WifiDevice::WifiDevice(std::string const& ifname, nlpp::if_type_e if_type,
+                       std::chrono::milliseconds max_age)
+: max_age_{max_age}
 { 
   ifindex_ = nlroute_.get_kernel(ifname).index().value();
 
@@ -21,53 +24,91 @@ WifiDevice::WifiDevice(std::string const& ifname, nlpp::if_type_e if_type)
 }
 
 
-std::string WifiDevice::name()
+std::shared_ptr<wifi_snapshot_t const> WifiDevice::snapshot(bool parallel)
+{
+  auto snapshot = std::make_shared<wifi_snapshot_t>();
+
+  // the subsystems have their own socket: the requests may overlap
+  auto fetch_link = [this, &snapshot] {
+    auto link = nlroute_.get_kernel(ifindex_);
+
+    snapshot->name = link.name();
+    snapshot->flags = link.flags();
+    snapshot->operstate = link.operstate();
+  };
+
+  if(parallel)
+  {
+    auto linked = std::async(std::launch::async, fetch_link);
+    snapshot->info = nlgeneric_.get_interface(ifindex_);
+    linked.get();
+  }
+  else
+  {
+    fetch_link();
+    snapshot->info = nlgeneric_.get_interface(ifindex_);
+  }
+
+  snapshot->taken = std::chrono::steady_clock::now();
+  snapshot_ = std::move(snapshot);
+
+  return snapshot_;
+}
+
+
+std::shared_ptr<wifi_snapshot_t const> WifiDevice::current()
 {
+  if(!snapshot_ || std::chrono::steady_clock::now() - snapshot_->taken >= max_age_) {
+    return this->snapshot();
+  }
 
-  return nlroute_.get_kernel(ifindex_).name();
+  return snapshot_;
 }
 
 
-bool WifiDevice::is_up() noexcept
+std::string WifiDevice::name()
 {
-  return nlroute_.get_kernel(ifindex_).flags().get().to_ulong() 
-    & std::to_underlying(nlpp::if_flag_e::up);
+  return this->current()->name;
+}
+
+
+bool WifiDevice::is_up()
+{
+  return this->current()->is_up();
 }
 
 
 nlpp::if_type_e WifiDevice::type()
 {
-  // FIXME: always check optionals!
-  return nlgeneric_.get_interface(nlroute_.get_kernel(ifindex_).index().value()).type;
+  return this->current()->info.type;
 }
 
 
 std::optional<nlpp::frequency_t> WifiDevice::frequency()
 {
-  auto frequency = nlgeneric_.get_interface(
-    nlroute_.get_kernel(ifindex_).index().value()).wiphy_freq;
-  
-  return frequency;
+  return this->current()->info.wiphy_freq;
 }
 
 
 std::optional<nlpp::channel_freq_t> WifiDevice::channel()
 {
-  auto frequency = nlgeneric_.get_interface(
-    nlroute_.get_kernel(ifindex_).index().value()).wiphy_freq;
+  auto const frequency = this->current()->info.wiphy_freq;
+  if(!frequency) {
+    return std::nullopt;
+  }
   
-  return nlpp::freq2chan(frequency.value());
+  return nlpp::freq2chan(*frequency);
 }
 
 
 std::string WifiDevice::to_string()
 {
-  auto link = nlroute_.get_kernel(ifindex_);
+  auto const state = this->current();
 
   return std::format("{}, state: {}, flags: {}", 
-    nlpp::to_string(nlgeneric_.get_interface(link.index().value())),
-    nlpp::to_string(link.operstate()), 
-    nlpp::to_string(link.flags()) );
+    nlpp::to_string(state->info),
+    nlpp::to_string(state->operstate), 
+    nlpp::to_string(state->flags) );
 }
 
 
@@ -78,6 +119,7 @@ void WifiDevice::put_up()
 
   change.set_flags(nlpp::if_flags_t{std::to_underlying(nlpp::if_flag_e::up)});
   nlroute_.link_change(current, change);
+  snapshot_.reset();
 }
 
 
@@ -88,6 +130,7 @@ void WifiDevice::put_down()
 
   change.unset_flags(nlpp::if_flags_t{std::to_underlying(nlpp::if_flag_e::up)});
   nlroute_.link_change(current, change);
+  snapshot_.reset();
 }
 
 
@@ -96,12 +139,14 @@ void WifiDevice::set_type(nlpp::if_type_e type)
   this->put_down();
   nlgeneric_.set_if_type(nlroute_.get_kernel(ifindex_).name(), type);
   this->put_up();
+  snapshot_.reset();
 }
 
 
 void WifiDevice::set_frequency(nlpp::frequency_t freq)
 {
   nlgeneric_.set_if_frequency(nlroute_.get_kernel(ifindex_).name(), freq);
+  snapshot_.reset();
 }
 
 
@@ -109,12 +154,13 @@ void WifiDevice::set_channel_freq(nlpp::channel_freq_t chan)
 {
   auto const freq = nlpp::chan2freq(chan);
   nlgeneric_.set_if_frequency(nlroute_.get_kernel(ifindex_).name(), freq);
+  snapshot_.reset();
 }
 
 
 nlpp::dev_info_t WifiDevice::dev_info()
 {
-  return nlgeneric_.get_interface(ifindex_);
+  return this->current()->info;
 }
 
 
@@ -0,0 +1,73 @@
+/**
+ * @file ChannelHopTest.cpp
+ * Test the no-wait API of `NetlinkGeneric` with a channel hopper.
+ */
+
+
+#include "nlpp/NetlinkGeneric.hpp"
+
+#include <chrono>
+#include <cstdlib>
+#include <print>
+#include <string>
+
+
+/**
+ * Hop over the 2.4 GHz channels without waiting for the kernel ACKs, then
+ * collect the errors of every hop. The request is encoded once and patched
+ * for every hop.
+ *
+ * How to test:
+ * 1) Plug a monitor-capable wlan dongle, in monitor mode and up
+ * 2) Execute `sudo ./ChannelHopTest <devname> [rounds]`
+ * 3) No error must be reported, and the elapsed time is printed
+ */
+int main(int argc, char* argv[])
+{
+  if(argc < 2) {
+    std::println(stderr, "error: wrong usage. Specify a monitor-capable wlan");
+    return EXIT_FAILURE;
+  }
+
+  std::string const ifname = argv[1];
+  int const rounds = argc > 2 ? std::atoi(argv[2]) : 10;
+
+  nlpp::NetlinkGeneric genl;
+  genl.socket().set_cap_ack(true);
+
+  std::println("=== Hop {} rounds over channels 1-13 of {} ===", rounds, ifname);
+
+  auto request = genl.prepare_set_if_frequency(ifname);
+
+  auto const start = std::chrono::steady_clock::now();
+
+  for(int round = 0; round != rounds; ++round)
+  {
+    for(int chan = 1; chan <= 13; ++chan)
+    {
+      auto seq = genl.post_set_if_channel(request, nlpp::channel_freq_t{chan});
+      if(!seq) {
+        std::println(stderr, "error: {}", seq.error().message());
+        return EXIT_FAILURE;
+      }
+    }
+  }
+
+  genl.socket().flush(std::chrono::seconds{5});
+
+  auto const elapsed = std::chrono::duration_cast<std::chrono::microseconds>(
+    std::chrono::steady_clock::now() - start);
+
+  int result = EXIT_SUCCESS;
+
+  for(auto const& ack: genl.collect_errors())
+  {
+    std::println(stderr, "seq {} (cmd {}): error {}", ack.seq, ack.cmd, ack.error);
+    result = EXIT_FAILURE;
+  }
+
+  std::println("{} hops in {}", rounds * 13, elapsed);
+
+
+  return result;
+}
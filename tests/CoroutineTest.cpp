@@ -0,0 +1,106 @@
+/**
+ * @file CoroutineTest.cpp
+ * Test the coroutine API of `NetlinkGeneric` and `NetlinkRoute`.
+ */
+
+
+#include "nlpp/NetlinkGeneric.hpp"
+#include "nlpp/NetlinkRoute.hpp"
+#include "nlpp/nlreactor_t.hpp"
+
+#include <cstdlib>
+#include <list>
+#include <print>
+#include <string>
+
+
+namespace {
+
+/// Put a link up or down.
+nlpp::task<> set_link(nlpp::NetlinkRoute& route, std::string const& ifname,
+                      bool up)
+{
+  auto current = route.get_kernel(ifname);
+  nlpp::rtnl_link_t change;
+  nlpp::if_flags_t const flag{std::to_underlying(nlpp::if_flag_e::up)};
+
+  up ? change.set_flags(flag) : change.unset_flags(flag);
+
+  return route.async_link_change(current, change);
+}
+
+
+/// Switch a device to monitor mode and tune it to channel 6.
+nlpp::task<> setup(nlpp::NetlinkGeneric& genl, nlpp::NetlinkRoute& route,
+                   std::string ifname)
+{
+  co_await set_link(route, ifname, false);
+  co_await genl.async_set_if_type(ifname, nlpp::if_type_e::monitor);
+  co_await set_link(route, ifname, true);
+  co_await genl.async_set_if_channel(ifname, nlpp::channel_freq_t{6});
+
+  auto const info = co_await genl.async_get_interface(
+    nlpp::if_index_t{if_nametoindex(ifname.c_str())});
+
+  std::println("{}", nlpp::to_string(info));
+}
+
+}
+
+
+/**
+ * The setup sequences of all devices overlap on a single thread.
+ *
+ * How to test:
+ * 1) Plug one or more monitor-capable wlan dongles
+ * 2) Execute `sudo ./CoroutineTest <devname>...`
+ * 3) Every device must be in monitor mode on channel 6
+ */
+int main(int argc, char* argv[])
+{
+  if(argc < 2) {
+    std::println(stderr, "error: wrong usage. Specify monitor-capable wlans");
+    return EXIT_FAILURE;
+  }
+
+  nlpp::nlreactor_t reactor;
+
+  struct device_t
+  {
+    nlpp::NetlinkGeneric genl;
+    nlpp::NetlinkRoute route;
+    nlpp::task<> setup;
+  };
+
+  std::list<device_t> devices;  // objects must not move once attached
+
+  std::println("=== Test the coroutine API with {} devices ===", argc - 1);
+
+  for(int i = 1; i != argc; ++i)
+  {
+    auto& device = devices.emplace_back();
+    device.genl.attach(reactor);
+    device.route.attach(reactor);
+
+    device.setup = setup(device.genl, device.route, argv[i]);
+    device.setup.start();
+  }
+
+  reactor.run();
+
+  int result = EXIT_SUCCESS;
+
+  for(auto& device: devices)
+  {
+    try {
+      device.setup.result();
+    }
+    catch(std::exception const& e) {
+      std::println(stderr, "error: {}", e.what());
+      result = EXIT_FAILURE;
+    }
+  }
+
+
+  return result;
+}
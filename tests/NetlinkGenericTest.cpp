@@ -5,19 +5,28 @@
 
 
 #include "nlpp/NetlinkGeneric.hpp"
+#include "nlpp/genl_family_cache_t.hpp"
 #include "nlpp/utils/WifiDevice.hpp"
 
+#include <algorithm>
 #include <cstdlib>
 #include <print>
+#include <utility>
 
 
 /**
  * This function cover all public methods ✅
  * - NetlinkGeneric()
+ * - genl_family_cache_t::misses()
  * - get_interface()
+ * - get_interfaces()
  * - get_list_interfaces()
+ * - get_list_interfaces(wiphy_index_t)
  * - get_phy()
  * - get_list_phys()
+ * - intersect(), unite()
+ * - for_each_interface(), for_each_phy()
+ * - stream_interfaces(), stream_phys()
  * - set_if_type()
  * - set_if_channel() -> set_if_frequency()
  *
@@ -37,6 +46,28 @@ int main(int argc, char* argv[])
 
   //* / / / / / / / / / / / / / / / / / / / / / / / / / / / / / / / / / / / / /
 
+  /**
+   * Short-lived objects reuse the family resolved by the first one.
+   */
+
+  std::println("=== Test `genl_family_cache_t` ===");
+
+  for(int i = 0; i != 16; ++i) {
+    [[maybe_unused]] nlpp::NetlinkGeneric other;
+  }
+
+  auto const misses = nlpp::genl_family_cache_t::instance().misses();
+
+  std::println("17 objects, {} controller round trips\n", misses);
+
+  if(misses != 1)
+  {
+    std::println(stderr, "error: the family was resolved {} times", misses);
+    return EXIT_FAILURE;
+  }
+
+  //* / / / / / / / / / / / / / / / / / / / / / / / / / / / / / / / / / / / / /
+
   /**
    * Get a list of all interfaces on this system with `get_list_interfaces()`.
    * Then, get each single interface with `get_interface()`.
@@ -52,6 +83,22 @@ int main(int argc, char* argv[])
     std::println("{}", nlpp::to_string(dev_info));
   };
 
+  /**
+   * Get the same interfaces again, pipelined in a single round trip with 
+   * `get_interfaces()`.
+   */
+
+  std::println("\n=== Test `get_interfaces()` ===");
+
+  std::vector<nlpp::if_index_t> if_indexes;
+  for(auto const& [if_index, _]: interfaces) {
+    if_indexes.emplace_back(if_index);
+  }
+
+  for(auto const& [_, dev_info]: genl.get_interfaces(if_indexes)) {
+    std::println("{}", nlpp::to_string(dev_info));
+  }
+
   //* / / / / / / / / / / / / / / / / / / / / / / / / / / / / / / / / / / / / / 
 
   /**
@@ -69,6 +116,93 @@ int main(int argc, char* argv[])
     std::println("{}\n", nlpp::to_string((phy)));
   }
 
+  /**
+   * Reduce the phys to the capabilities they share.
+   */
+
+  std::println("\n=== Test `intersect()` and `unite()` ===");
+
+  auto const common = nlpp::intersect(phys);
+  auto const any = nlpp::unite(phys);
+
+  std::println("usable freqs: {} shared, {} in total", 
+    common.channels.size(), any.channels.size());
+  std::println("monitor mode shared: {}", 
+    common.iftypes[std::to_underlying(nlpp::if_type_e::monitor)]);
+
+  /**
+   * Get the interfaces of each phy, filtered by the kernel.
+   */
+
+  std::println("\n=== Test `get_list_interfaces(wiphy_index_t)` ===");
+
+  for(auto const& [phy_index, dev_cap]: phys)
+  {
+    for(auto const& [_, dev_info]: genl.get_list_interfaces(dev_cap.wiphy_index)) {
+      std::println("phy#{}: {}", phy_index, dev_info.if_name);
+    }
+  }
+
+  //* / / / / / / / / / / / / / / / / / / / / / / / / / / / / / / / / / / / / /
+
+  /**
+   * Stream the same dumps, which must report the same objects.
+   */
+
+  std::println("\n=== Test `for_each_interface()` and `stream_interfaces()` ===");
+
+  std::size_t visited = 0;
+  genl.for_each_interface([&](nlpp::dev_info_t&& dev_info) {
+    visited += interfaces.contains(dev_info.if_index.get());
+    return true;
+  });
+
+  std::size_t streamed = 0;
+  for(auto const& dev_info: genl.stream_interfaces()) {
+    streamed += interfaces.contains(dev_info.if_index.get());
+  }
+
+  std::println("{} interfaces, {} visited, {} streamed", 
+    interfaces.size(), visited, streamed);
+
+  std::println("\n=== Test `for_each_phy()` and `stream_phys()` ===");
+
+  visited = 0;
+  genl.for_each_phy([&](nlpp::dev_capability_t&& phy) {
+    visited += phys.at(phy.wiphy_index.get()).channels.freqs == phy.channels.freqs;
+    return true;
+  });
+
+  streamed = 0;
+  for(auto const& phy: genl.stream_phys()) 
+  {
+    streamed += phys.at(phy.wiphy_index.get()).channels.freqs == phy.channels.freqs;
+    break;  // stop the dump early: the next request must not see its leftover
+  }
+
+  std::println("{} phys, {} visited, {} streamed before the break", 
+    phys.size(), visited, streamed);
+
+  // a dump abandoned halfway must not leave the socket busy
+  for([[maybe_unused]] auto const& dev_info: genl.stream_interfaces()) {
+    break;
+  }
+
+  if(auto const after = genl.try_get_list_interfaces(); !after)
+  {
+    std::println(stderr, "error: dump after a break: {}", after.error().message());
+    return EXIT_FAILURE;
+  }
+
+  genl.for_each_interface([](nlpp::dev_info_t&&) { return false; });
+
+  if(auto const after = genl.try_get_list_interfaces(); !after)
+  {
+    std::println(stderr, "error: dump after a stopped visit: {}", 
+      after.error().message());
+    return EXIT_FAILURE;
+  }
+
   //* / / / / / / / / / / / / / / / / / / / / / / / / / / / / / / / / / / / / /
 
   /**
@@ -122,15 +256,18 @@ int main(int argc, char* argv[])
     return EXIT_FAILURE;
   }
 
-  auto const current_channel = 
-    nlpp::freq2chan(found_it->second.wiphy_freq.value());
+  // hop to the next channel which is not disabled, so the kernel accepts it
+  auto const usable = 
+    phys.at(found_it->second.wiphy_index.get()).usable_freqs();
 
-  auto const max_channel = 
-    nlpp::freq2chan(phys.at(found_it->second.wiphy_index.get()).freqs.back());
+  auto const current = found_it->second.wiphy_freq.value().get();
+  auto next = std::ranges::find_if(usable, 
+    [current](auto freq) { return freq.get() > current; });
+  if(next == std::end(usable)) {
+    next = std::begin(usable);
+  }
 
-  auto const new_channel = 
-    nlpp::channel_freq_t{
-      current_channel != max_channel ? (current_channel.get()+1) : 1};
+  auto const new_channel = nlpp::freq2chan(*next);
 
   genl.set_if_channel(if_name, new_channel);
 
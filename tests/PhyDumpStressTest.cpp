@@ -0,0 +1,108 @@
+/**
+ * @file PhyDumpStressTest.cpp
+ * Stress test of concurrent capability dumps of `NetlinkGeneric`.
+ */
+
+
+#include "nlpp/NetlinkGeneric.hpp"
+
+#include <atomic>
+#include <cstdlib>
+#include <map>
+#include <print>
+#include <thread>
+#include <vector>
+
+
+namespace {
+
+
+/// @brief Field by field comparison, `operator==` only compares the identity.
+bool same(nlpp::dev_capability_t const& lhs, nlpp::dev_capability_t const& rhs)
+{
+  return lhs.wiphy_index == rhs.wiphy_index
+    && lhs.wiphy_name == rhs.wiphy_name
+    && lhs.iftypes == rhs.iftypes
+    && lhs.channels.freqs == rhs.channels.freqs
+    && lhs.channels.flags == rhs.channels.flags
+    && lhs.channels.max_tx_power == rhs.channels.max_tx_power
+    && lhs.channels.bands.size() == rhs.channels.bands.size()
+    && lhs.channels.usable == rhs.channels.usable
+    && lhs.cmds == rhs.cmds;
+}
+
+
+bool same(std::map<uint32_t,nlpp::dev_capability_t> const& lhs,
+          std::map<uint32_t,nlpp::dev_capability_t> const& rhs)
+{
+  if(lhs.size() != rhs.size()) {
+    return false;
+  }
+
+  for(auto const& [phy, caps] : lhs)
+  {
+    auto found = rhs.find(phy);
+    if(found == std::end(rhs) || !same(caps, found->second)) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+
+}
+
+
+/**
+ * Dump the capabilities of every phy serially, then from several threads at
+ * once, each one with its own `NetlinkGeneric`. Every concurrent dump must
+ * be identical to the serial one.
+ *
+ * How to test:
+ * 1) Plug at least a wlan device
+ * 2) Execute `./PhyDumpStressTest [threads] [iterations]`
+ * 3) No mismatch nor error must be reported
+ */
+int main(int argc, char* argv[])
+{
+  int const threads = argc > 1 ? std::atoi(argv[1]) : 8;
+  int const iterations = argc > 2 ? std::atoi(argv[2]) : 100;
+
+  auto const baseline = nlpp::NetlinkGeneric{}.get_list_phys();
+
+  std::println("=== {} phys, {} threads x {} dumps ===",
+               baseline.size(), threads, iterations);
+
+  std::atomic<int> mismatches{0};
+  std::atomic<int> errors{0};
+
+  {
+    std::vector<std::jthread> workers;
+    workers.reserve(threads);
+
+    for(int t = 0; t != threads; ++t)
+    {
+      workers.emplace_back([&] {
+        nlpp::NetlinkGeneric genl;
+
+        for(int i = 0; i != iterations; ++i)
+        {
+          auto phys = genl.try_get_list_phys();
+          if(!phys) {
+            ++errors;
+            std::println(stderr, "error: {}", phys.error().message());
+          }
+          else if(!same(*phys, baseline)) {
+            ++mismatches;
+          }
+        }
+      });
+    }
+  }
+
+  std::println("mismatches: {}, errors: {}", mismatches.load(), errors.load());
+
+
+  return mismatches == 0 && errors == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
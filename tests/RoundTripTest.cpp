@@ -0,0 +1,123 @@
+/**
+ * @file RoundTripTest.cpp
+ * Count the requests each `NetlinkGeneric` call sends to the kernel.
+ */
+
+
+#include "nlpp/NetlinkGeneric.hpp"
+#include "nlpp/nlreactor_t.hpp"
+
+#include <dlfcn.h>
+#include <linux/genetlink.h>
+#include <linux/nl80211.h>
+
+#include <cstdlib>
+#include <map>
+#include <print>
+#include <utility>
+
+
+namespace {
+
+/// Number of requests sent, by (family, command).
+std::map<std::pair<uint16_t,uint8_t>,std::size_t> round_trips;
+
+
+/// Returns the number of requests of a nl80211 command sent so far.
+std::size_t count(nlpp::NetlinkGeneric const& genl, nl80211_commands cmd)
+{
+  auto const key = std::pair{static_cast<uint16_t>(genl.family_id()),
+                             static_cast<uint8_t>(cmd)};
+
+  auto found = round_trips.find(key);
+  return found != std::end(round_trips) ? found->second : 0;
+}
+
+
+nlpp::task<> async_phys(nlpp::NetlinkGeneric& genl, nlpp::wiphy_index_t phy)
+{
+  [[maybe_unused]] auto const one = co_await genl.async_get_phy(phy);
+  [[maybe_unused]] auto const all = co_await genl.async_get_list_phys();
+}
+
+}
+
+
+/**
+ * Interpose `nl_send_auto()`, which every request goes through, to count
+ * the requests by command. The real function is looked up in libnl.
+ */
+extern "C" int nl_send_auto(struct nl_sock* sk, struct nl_msg* msg)
+{
+  using nl_send_auto_fn = int (*)(struct nl_sock*, struct nl_msg*);
+
+  static auto const real =
+    reinterpret_cast<nl_send_auto_fn>(dlsym(RTLD_NEXT, "nl_send_auto"));
+
+  auto const* hdr = nlmsg_hdr(msg);
+  auto const* gnlh = reinterpret_cast<genlmsghdr const*>(nlmsg_data(hdr));
+
+  ++round_trips[{hdr->nlmsg_type, gnlh->cmd}];
+  return real(sk, msg);
+}
+
+
+/**
+ * The protocol features are probed once for the lifetime of an object.
+ *
+ * How to test:
+ * 1) Plug at least one wlan dongle
+ * 2) Execute `./RoundTripTest [iterations]`
+ * 3) `GET_PROTOCOL_FEATURES` must be sent once, whatever the iterations
+ */
+int main(int argc, char* argv[])
+{
+  std::size_t const iterations = argc > 1 ? std::atol(argv[1]) : 8;
+
+  nlpp::NetlinkGeneric genl;
+
+  std::println("=== Test the round trips of {} phy queries ===", iterations);
+  std::println("protocol features: {:#x}", genl.protocol_features().to_ulong());
+
+  auto const phys = genl.get_list_phys();
+  if(phys.empty()) {
+    std::println(stderr, "error: no phy");
+    return EXIT_FAILURE;
+  }
+
+  nlpp::wiphy_index_t const phy{std::begin(phys)->first};
+
+  nlpp::nlreactor_t reactor;
+  genl.attach(reactor);
+
+  for(std::size_t i = 0; i != iterations; ++i)
+  {
+    [[maybe_unused]] auto const one = genl.get_phy(phy);
+    [[maybe_unused]] auto const all = genl.get_list_phys();
+
+    genl.for_each_phy([](nlpp::dev_capability_t&&) { return true; });
+
+    for([[maybe_unused]] auto& capability: genl.stream_phys()) {}
+
+    auto task = async_phys(genl, phy);
+    task.start();
+    reactor.run();
+    task.result();
+  }
+
+  std::println("{:>24} {:>8}", "family/cmd", "requests");
+  for(auto const& [key, requests]: round_trips) {
+    std::println("{:>19}/{:<4} {:>8}", key.first, key.second, requests);
+  }
+
+  auto const probes = count(genl, NL80211_CMD_GET_PROTOCOL_FEATURES);
+  std::println("GET_PROTOCOL_FEATURES: {}", probes);
+
+  if(probes != 1) {
+    std::println(stderr, "error: protocol features probed {} times", probes);
+    return EXIT_FAILURE;
+  }
+
+
+  return EXIT_SUCCESS;
+}
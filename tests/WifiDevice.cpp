@@ -12,6 +12,11 @@ int main(int argc, char* argv[])
 
   std::println("{}", device.to_string()); // print some info
 
+  // one rtnl and one nl80211 round trip, overlapped, for all the getters
+  auto const state = device.snapshot(true);
+  std::println("{}: up {}, type {}", state->name, state->is_up(),
+    nlpp::to_string(state->info.type));
+
   std::println("Put the device down");
   device.put_down();
   
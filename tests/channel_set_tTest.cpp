@@ -0,0 +1,83 @@
+/**
+ * @file channel_set_tTest.cpp
+ * Check that `channel_set_t` stores exactly the channel frequencies.
+ */
+
+
+#include "nlpp/nlpp.hpp"
+
+#include <cstdlib>
+#include <print>
+#include <vector>
+
+
+/**
+ * Insert the channels of every band, then read them back.
+ *
+ * How to test:
+ * 1) Execute `./channel_set_tTest`
+ * 2) It must print `ok`: `freqs()` gives back the inserted frequencies and
+ *    off-grid frequencies are rejected
+ */
+int main()
+{
+  std::vector<nlpp::frequency_t> inserted;
+
+  for(unsigned chan = 1; chan <= 14; ++chan) {
+    inserted.push_back(nlpp::chan2freq(nlpp::channel_freq_t{static_cast<int>(chan)}));
+  }
+  for(unsigned freq = 4915; freq <= 4980; freq += 5) {  // 4.9 GHz
+    inserted.emplace_back(freq);
+  }
+  for(unsigned freq = 5180; freq <= 5885; freq += 20) { // 5 GHz
+    inserted.emplace_back(freq);
+  }
+  for(unsigned freq = 5955; freq <= 7115; freq += 20) { // 6 GHz
+    inserted.emplace_back(freq);
+  }
+  for(unsigned freq = 58320; freq <= 69120; freq += 2160) { // 60 GHz
+    inserted.emplace_back(freq);
+  }
+
+  nlpp::channel_set_t set;
+  int failures = 0;
+
+  for(auto const freq: inserted)
+  {
+    if(!set.insert(freq)) {
+      std::println(stderr, "error: {} MHz rejected", freq.get());
+      ++failures;
+    }
+  }
+
+  if(set.freqs() != inserted) {
+    std::println(stderr, "error: freqs() differs from the inserted frequencies");
+    ++failures;
+  }
+
+  if(set.size() != inserted.size()) {
+    std::println(stderr, "error: {} frequencies, {} inserted", set.size(),
+      inserted.size());
+    ++failures;
+  }
+
+  // aliases of the channels, which are not channels themselves
+  for(unsigned const freq: {2410u, 2411u, 2413u, 2480u, 2485u, 5182u, 58321u})
+  {
+    nlpp::channel_set_t off;
+
+    if(off.insert(nlpp::frequency_t{freq}) || set.contains(nlpp::frequency_t{freq})) {
+      std::println(stderr, "error: off-grid {} MHz accepted", freq);
+      ++failures;
+    }
+  }
+
+  if(failures) {
+    return EXIT_FAILURE;
+  }
+
+  std::println("ok");
+
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,79 @@
+/**
+ * @file nl80211_cache_tTest.cpp
+ * Test the event-driven `nl80211_cache_t`.
+ */
+
+
+#include "nlpp/nl80211_cache_t.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <print>
+#include <thread>
+
+
+namespace {
+
+/// Print the interfaces of a state.
+void print(nlpp::nl80211_state_t const& state)
+{
+  std::println("--- generation {}: {} phys ---", state.generation,
+    state.phys.size());
+
+  for(auto const& [ifindex, info]: state.interfaces) {
+    std::println("{}", nlpp::to_string(info));
+  }
+}
+
+}
+
+
+/**
+ * Follow the nl80211 changes while a reader thread polls the snapshots.
+ *
+ * How to test:
+ * 1) Execute `./nl80211_cache_tTest [seconds]`
+ * 2) Meanwhile, e.g. `sudo iw dev wlan0 set type monitor`, `sudo iw phy
+ *    phy0 interface add mon0 type monitor`, `sudo iw dev mon0 del`, or
+ *    unplug and plug a dongle
+ * 3) Each change must be printed, without any request but phy fetches
+ */
+int main(int argc, char* argv[])
+{
+  using namespace std::chrono_literals;
+
+  auto const duration = std::chrono::seconds{argc > 1 ? std::atol(argv[1]) : 30};
+
+  nlpp::nl80211_cache_t cache;
+  std::atomic<std::size_t> reads{};
+
+  std::println("=== Test `nl80211_cache_t` for {} ===", duration);
+  print(*cache.snapshot());
+
+  std::jthread reader{[&cache, &reads](std::stop_token stop) {
+    while(!stop.stop_requested())
+    {
+      auto const state = cache.snapshot();
+      [[maybe_unused]] auto const* info = state->interface("wlan0");
+      ++reads;
+    }
+  }};
+
+  auto const deadline = std::chrono::steady_clock::now() + duration;
+
+  while(std::chrono::steady_clock::now() < deadline)
+  {
+    if(cache.process_events(500ms)) {
+      print(*cache.snapshot());
+    }
+  }
+
+  reader.request_stop();
+  reader.join();
+
+  std::println("reads: {}", reads.load());
+
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,82 @@
+/**
+ * @file nlcache_mngr_tTest.cpp
+ * Test the auto-refreshing link cache `nlcache_mngr_t`.
+ */
+
+
+#include "nlpp/nlcache_mngr_t.hpp"
+
+#include <chrono>
+#include <cstdlib>
+#include <print>
+#include <string>
+
+
+namespace {
+
+/// Returns the name of an action.
+char const* to_string(nlpp::cache_action_e action)
+{
+  switch(action)
+  {
+    case nlpp::cache_action_e::add:    return "add";
+    case nlpp::cache_action_e::del:    return "del";
+    case nlpp::cache_action_e::change: return "change";
+  }
+
+  return "?";
+}
+
+}
+
+
+/**
+ * Follow the link changes and look a device up from the live cache.
+ *
+ * How to test:
+ * 1) Execute `./nlcache_mngr_tTest <devname> [seconds]`
+ * 2) Meanwhile, e.g. `sudo ip link set <devname> down`, `... up`, or rename
+ *    the device
+ * 3) Each change must be printed, and the lookups must follow it
+ */
+int main(int argc, char* argv[])
+{
+  using namespace std::chrono_literals;
+
+  if(argc < 2) {
+    std::println(stderr, "error: wrong usage. Specify a device");
+    return EXIT_FAILURE;
+  }
+
+  std::string const ifname = argv[1];
+  auto const duration = std::chrono::seconds{argc > 2 ? std::atol(argv[2]) : 30};
+
+  nlpp::nlcache_mngr_t links;
+
+  std::println("=== Test `nlcache_mngr_t` for {}: {} links ===", duration,
+    links.size());
+
+  links.set_change_handler([](nlpp::cache_action_e action, nlpp::rtnl_link_t& link) {
+    std::println("{}: {}", to_string(action), link.to_string());
+  });
+
+  auto const deadline = std::chrono::steady_clock::now() + duration;
+
+  while(std::chrono::steady_clock::now() < deadline)
+  {
+    if(!links.poll(500ms)) {
+      continue;
+    }
+
+    if(auto link = links.get_link(ifname)) {
+      std::println("{}: index {}, flags {}", ifname, link->index()->get(),
+        nlpp::to_string(link->flags()));
+    }
+    else {
+      std::println("{}: gone", ifname);
+    }
+  }
+
+
+  return EXIT_SUCCESS;
+}
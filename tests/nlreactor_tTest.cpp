@@ -0,0 +1,86 @@
+/**
+ * @file nlreactor_tTest.cpp
+ * Test the `nlreactor_t` class.
+ */
+
+
+#include "nlpp/NetlinkGeneric.hpp"
+#include "nlpp/nlreactor_t.hpp"
+
+#include <chrono>
+#include <cstdlib>
+#include <list>
+#include <print>
+
+
+namespace {
+
+/// Count the interfaces of a `NL80211_CMD_GET_INTERFACE` dump.
+int count_handler(struct nl_msg*, void* arg) noexcept
+{
+  ++*reinterpret_cast<std::size_t*>(arg);
+  return NL_SKIP;
+}
+
+}
+
+
+/**
+ * Drive many genl sockets from a single thread: each one dumps all interfaces
+ * concurrently, and completions are invoked by the reactor.
+ *
+ * How to test:
+ * 1) Execute `./nlreactor_tTest [sockets]`
+ * 2) Every socket must report the same number of interfaces and no error
+ */
+int main(int argc, char* argv[])
+{
+  std::size_t const count = argc > 1 ? std::atol(argv[1]) : 32;
+
+  struct client_t
+  {
+    nlpp::NetlinkGeneric genl;
+    std::size_t interfaces{};
+    int error{1};
+  };
+
+  std::list<client_t> clients(count);  // sockets must not move once registered
+  nlpp::nlreactor_t reactor;
+
+  std::println("=== Test `nlreactor_t` with {} sockets ===", count);
+
+  std::list<nlpp::nlmsg_t> msgs;
+
+  for(auto& client: clients)
+  {
+    reactor.add(client.genl.socket());
+
+    auto& msg = msgs.emplace_back(
+      client.genl.family_id(), NL80211_CMD_GET_INTERFACE, NLM_F_DUMP);
+
+    client.genl.socket().send_async(msg, count_handler, &client.interfaces,
+      [&client](int error) { client.error = error; });
+  }
+
+  int result = EXIT_SUCCESS;
+
+  // a lost reply must not hang the loop
+  if(!reactor.run(std::chrono::seconds{5}))
+  {
+    std::println(stderr, "error: replies still pending after 5 s");
+    result = EXIT_FAILURE;
+  }
+
+  for(std::size_t i = 0; auto const& client: clients)
+  {
+    std::println("socket {}: {} interfaces, error {}",
+      i++, client.interfaces, client.error);
+
+    if(client.error != 0) {
+      result = EXIT_FAILURE;
+    }
+  }
+
+
+  return result;
+}
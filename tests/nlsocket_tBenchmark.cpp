@@ -0,0 +1,169 @@
+/**
+ * @file nlsocket_tBenchmark.cpp
+ * Microbenchmark for the `nlsocket_t` request path.
+ */
+
+
+#include "nlpp/NetlinkGeneric.hpp"
+
+#include <dlfcn.h>
+#include <netlink/errno.h>
+
+#include <cerrno>
+#include <chrono>
+#include <cstdlib>
+#include <print>
+#include <utility>
+#include <vector>
+
+
+namespace {
+
+std::size_t cb_allocs{};  // number of `nl_cb_alloc()` calls
+int recv_failure{};       // libnl error of the next `nl_recvmsgs()`, if any
+
+}
+
+
+/**
+ * Interpose `nl_cb_alloc()` to count how many callback sets are allocated.
+ * The real function is looked up in the next object (libnl).
+ */
+extern "C" struct nl_cb* nl_cb_alloc(enum nl_cb_kind kind)
+{
+  using nl_cb_alloc_fn = struct nl_cb* (*)(enum nl_cb_kind);
+
+  static auto const real =
+    reinterpret_cast<nl_cb_alloc_fn>(dlsym(RTLD_NEXT, "nl_cb_alloc"));
+
+  ++cb_allocs;
+  return real(kind);
+}
+
+
+/**
+ * Interpose `nl_recvmsgs()` to fail it once with `recv_failure`.
+ * The real function is looked up in the next object (libnl).
+ */
+extern "C" int nl_recvmsgs(struct nl_sock* sk, struct nl_cb* cb)
+{
+  using nl_recvmsgs_fn = int (*)(struct nl_sock*, struct nl_cb*);
+
+  static auto const real =
+    reinterpret_cast<nl_recvmsgs_fn>(dlsym(RTLD_NEXT, "nl_recvmsgs"));
+
+  if(int err = std::exchange(recv_failure, 0); err) {
+    return err;
+  }
+
+  return real(sk, cb);
+}
+
+
+/**
+ * Measure the `nl_cb_alloc()` count and the average latency of a request,
+ * then compare a batch of `get_interface()` requests with serial ones.
+ *
+ * How to test:
+ * 1) Execute `./nlsocket_tBenchmark [iterations]`
+ * 2) `cb allocs/request` must be zero, the batched replies must equal
+ *    the serial ones, and a failed batch must leave a negated errno in its
+ *    pending requests
+ */
+int main(int argc, char* argv[])
+{
+  std::size_t const iterations = argc > 1 ? std::atol(argv[1]) : 10'000;
+
+  nlpp::NetlinkGeneric genl;
+
+  std::println("=== Benchmark `get_list_interfaces()` x {} ===", iterations);
+
+  cb_allocs = 0;
+  auto const start = std::chrono::steady_clock::now();
+
+  for(std::size_t i = 0; i != iterations; ++i) {
+    [[maybe_unused]] auto const interfaces = genl.get_list_interfaces();
+  }
+
+  auto const elapsed = std::chrono::steady_clock::now() - start;
+
+  std::println("cb allocs/request: {}",
+    static_cast<double>(cb_allocs) / iterations);
+  std::println("latency/request: {}",
+    std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed) / iterations);
+
+  std::vector<nlpp::if_index_t> if_indexes;
+  for(auto const& [if_index, _]: genl.get_list_interfaces()) {
+    if_indexes.emplace_back(if_index);
+  }
+
+  std::println("\n=== Benchmark `get_interfaces()` of {} devices x {} ===", 
+    if_indexes.size(), iterations);
+
+  auto const batched = genl.get_interfaces(if_indexes);
+  auto const batch_start = std::chrono::steady_clock::now();
+
+  for(std::size_t i = 0; i != iterations; ++i) {
+    [[maybe_unused]] auto const interfaces = genl.get_interfaces(if_indexes);
+  }
+
+  auto const batch_elapsed = std::chrono::steady_clock::now() - batch_start;
+  auto const serial_start = std::chrono::steady_clock::now();
+
+  for(std::size_t i = 0; i != iterations; ++i) 
+  {
+    for(auto const if_index: if_indexes) {
+      [[maybe_unused]] auto const dev_info = genl.get_interface(if_index);
+    }
+  }
+
+  auto const serial_elapsed = std::chrono::steady_clock::now() - serial_start;
+
+  std::println("latency/batch: {}, latency/serial: {}",
+    std::chrono::duration_cast<std::chrono::nanoseconds>(batch_elapsed) / iterations,
+    std::chrono::duration_cast<std::chrono::nanoseconds>(serial_elapsed) / iterations);
+
+  // the replies are routed by sequence number: each must match its request
+  if(batched.size() != if_indexes.size())
+  {
+    std::println(stderr, "error: {} batched replies for {} requests", 
+      batched.size(), if_indexes.size());
+    return EXIT_FAILURE;
+  }
+
+  for(auto const if_index: if_indexes)
+  {
+    auto const serial = nlpp::to_string(genl.get_interface(if_index));
+    auto const found = batched.find(if_index.get());
+
+    if(found == std::end(batched) || nlpp::to_string(found->second) != serial) 
+    {
+      std::println(stderr, "error: batched reply of {} differs: {}", 
+        if_index.get(), serial);
+      return EXIT_FAILURE;
+    }
+  }
+
+  std::println("batched replies equal the serial ones");
+
+  std::println("\n=== Test a batch failed by libnl ===");
+
+  nlpp::nlsocket_t socket{nlpp::netlink_protocol_e::generic};
+  nlpp::nlmsg_t msg{genl.family_id(), NL80211_CMD_GET_PROTOCOL_FEATURES};
+  std::vector<nlpp::nlrequest_t> failed(1);
+  failed.front().msg = &msg;
+
+  recv_failure = -NLE_MSG_TOOSHORT;
+
+  if(socket.try_transact(failed) || failed.front().error != -EBADMSG)
+  {
+    std::println(stderr, "error: failed request holds {}, not {}", 
+      failed.front().error, -EBADMSG);
+    return EXIT_FAILURE;
+  }
+
+  std::println("failed request holds -EBADMSG");
+
+
+  return EXIT_SUCCESS;
+}
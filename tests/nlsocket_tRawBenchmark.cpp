@@ -0,0 +1,170 @@
+/**
+ * @file nlsocket_tRawBenchmark.cpp
+ * Microbenchmark of `nlsocket_t::recv_raw()` against the libnl receive path.
+ */
+
+
+#include "nlpp/NetlinkGeneric.hpp"
+
+#include <netlink/attr.h>
+#include <netlink/genl/genl.h>
+#include <netlink/msg.h>
+
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <print>
+#include <vector>
+
+
+namespace {
+
+
+/// @brief Counts the messages and the attributes of a dump.
+struct counter_t
+{
+  std::size_t msgs{};
+  std::size_t attrs{};
+};
+
+
+int libnl_handler(struct nl_msg* msg, void* arg)
+{
+  auto* count = reinterpret_cast<counter_t*>(arg);
+  struct nlattr* tb[NL80211_ATTR_MAX + 1];
+
+  auto* gnlh = reinterpret_cast<genlmsghdr*>(nlmsg_data(nlmsg_hdr(msg)));
+  nla_parse(tb, NL80211_ATTR_MAX, genlmsg_attrdata(gnlh, 0),
+            genlmsg_attrlen(gnlh, 0), nullptr);
+
+  ++count->msgs;
+  count->attrs += tb[NL80211_ATTR_WIPHY] != nullptr;
+
+  return NL_SKIP;
+}
+
+
+int view_handler(nlpp::nlmsg_view_t msg, void* arg)
+{
+  auto* count = reinterpret_cast<counter_t*>(arg);
+  auto const tb = msg.genl_attrs().table<NL80211_ATTR_MAX>();
+
+  ++count->msgs;
+  count->attrs += static_cast<bool>(tb[NL80211_ATTR_WIPHY]);
+
+  return NL_SKIP;
+}
+
+
+/// @brief Copy every message of a dump, to replay it without the kernel.
+int record_handler(nlpp::nlmsg_view_t msg, void* arg)
+{
+  auto* buffer = reinterpret_cast<std::vector<std::byte>*>(arg);
+  auto const* first = reinterpret_cast<std::byte const*>(msg.hdr());
+
+  buffer->insert(buffer->end(), first, first + msg.hdr()->nlmsg_len);
+  buffer->resize(NLMSG_ALIGN(buffer->size()));
+
+  return NL_SKIP;
+}
+
+
+nlpp::nlmsg_t make_dump(int family)
+{
+  nlpp::nlmsg_t msg{family, NL80211_CMD_GET_WIPHY, NLM_F_DUMP};
+  msg.put_flag(NL80211_ATTR_SPLIT_WIPHY_DUMP);
+
+  return msg;
+}
+
+
+template <typename F>
+std::chrono::nanoseconds measure(std::size_t iterations, F&& fun)
+{
+  auto const start = std::chrono::steady_clock::now();
+
+  for(std::size_t i = 0; i != iterations; ++i) {
+    fun();
+  }
+
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+    std::chrono::steady_clock::now() - start) / iterations;
+}
+
+
+}
+
+
+/**
+ * Compare the libnl receive path with the in-place one, on a live split
+ * wiphy dump and on a replay of it, which excludes the syscalls.
+ *
+ * How to test:
+ * 1) Plug at least a wlan device
+ * 2) Execute `./nlsocket_tRawBenchmark [iterations]`
+ * 3) Both paths must count the same messages, `recv_raw()` must be faster
+ */
+int main(int argc, char* argv[])
+{
+  std::size_t const iterations = argc > 1 ? std::atol(argv[1]) : 1'000;
+
+  nlpp::NetlinkGeneric genl;
+  auto& socket = genl.socket();
+  auto const msg = make_dump(genl.family_id());
+
+  std::println("=== Live split wiphy dump x {} ===", iterations);
+
+  counter_t libnl_count;
+  auto const libnl_live = measure(iterations, [&] {
+    socket.send_auto(msg);
+    socket.recvmsgs(libnl_handler, &libnl_count);
+  });
+
+  counter_t view_count;
+  auto const view_live = measure(iterations, [&] {
+    socket.send_auto(msg);
+    socket.recv_raw(view_handler, &view_count);
+  });
+
+  std::println("libnl:    {} msgs, {}/dump", libnl_count.msgs, libnl_live);
+  std::println("recv_raw: {} msgs, {}/dump", view_count.msgs, view_live);
+
+  // record one dump, then parse it again and again
+  std::vector<std::byte> recorded;
+  socket.send_auto(msg);
+  socket.recv_raw(record_handler, &recorded);
+
+  std::println("=== Replay of {} bytes x {} ===", recorded.size(), iterations);
+
+  auto walk = [&](auto&& fun) {
+    auto const* hdr = reinterpret_cast<struct nlmsghdr*>(recorded.data());
+    auto left = static_cast<int>(recorded.size());
+
+    for(; NLMSG_OK(hdr, left); hdr = NLMSG_NEXT(hdr, left)) {
+      fun(const_cast<struct nlmsghdr*>(hdr));
+    }
+  };
+
+  // libnl allocates and copies a `struct nl_msg` for every message received
+  libnl_count = {};
+  auto const libnl_replay = measure(iterations, [&] {
+    walk([&](struct nlmsghdr* hdr) {
+      auto* msgPtr = nlmsg_convert(hdr);
+      libnl_handler(msgPtr, &libnl_count);
+      nlmsg_free(msgPtr);
+    });
+  });
+
+  view_count = {};
+  auto const view_replay = measure(iterations, [&] {
+    walk([&](struct nlmsghdr* hdr) {
+      view_handler(nlpp::nlmsg_view_t{hdr}, &view_count);
+    });
+  });
+
+  std::println("libnl:    {} msgs, {}/dump", libnl_count.msgs, libnl_replay);
+  std::println("recv_raw: {} msgs, {}/dump", view_count.msgs, view_replay);
+
+
+  return libnl_count.msgs == view_count.msgs ? EXIT_SUCCESS : EXIT_FAILURE;
+}